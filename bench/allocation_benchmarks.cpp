@@ -0,0 +1,136 @@
+#include "suites.h"
+
+#include <functional>
+#include <memory>
+
+#include "allocation_counter.h"
+#include "uno_game.h"
+#include "RandomBot.h"
+#include "Pudge_player.h"
+
+/**
+ * @brief Бот, который сам не обращается к куче: кладет первую подходящую
+ * карту, не кладет вытянутые и говорит "Uno!" перед последней картой.
+ * Нужен, чтобы считать выделения памяти самой игры.
+*/
+class EngineBot: public UnoPlayer
+{
+public:
+    std::string name() const override { return "EngineBot"; }
+    void receiveCards(CardSpan cards) override {}
+
+    const Card * playCard() override
+    {
+        CardSpan hand = myHand();
+        const Card * top = game()->topCard();
+        const CardColor color = game()->currentColor();
+        size_t wildDraw4 = hand.size();
+        for (size_t i = 0; i < hand.size(); ++i)
+        {
+            const Card * card = hand[i];
+            if (card->value == CardValue::WildDraw4) 
+            {
+                wildDraw4 = i;
+                continue;
+            }
+            if (card->is_wild() || card->color == color || card->value == top->value)
+            {
+                if (hand.size() == 2) say("Uno!");
+                return card;
+            }
+        }
+        // Игра спрашивает карту, только если ход есть
+        return hand[wildDraw4];
+    }
+
+    bool drawAdditionalCard(const Card * additionalCard) override { return false; }
+
+    CardColor changeColor() override { return CardColor::Red; }
+};
+
+/// @brief Выделения памяти за партии после разогрева.
+struct SetAllocations
+{
+    std::uint64_t allocations, bytes, sets, turns;
+};
+
+static SetAllocations measureSets(
+    const PlayerFactory& factory, int players, int warmupSets, int sets)
+{
+    UnoGame game(GameConfig::forTable(players));
+    game.setRandomGeneratorSeed(42);
+    std::vector<std::unique_ptr<UnoPlayer>> seats;
+    for (int i = 0; i < players; ++i)
+    {
+        seats.push_back(factory());
+        game.addPlayer(seats.back().get());
+    }
+    game.initPlayerInfo();
+    for (int i = 0; i < warmupSets; ++i) game.runSet();
+
+    SetAllocations result = {0, 0, static_cast<std::uint64_t>(sets), 0};
+    const std::uint64_t allocationsBefore = allocationCount();
+    const std::uint64_t bytesBefore = allocatedBytes();
+    for (int i = 0; i < sets; ++i) 
+    {
+        game.runSet();
+        result.turns += game.currentTurnNumber();
+    }
+    result.allocations = allocationCount() - allocationsBefore;
+    result.bytes = allocatedBytes() - bytesBefore;
+    return result;
+}
+
+struct AllocationKind
+{
+    const char * name;
+    PlayerFactory factory;
+};
+
+static const AllocationKind * allocationKinds(size_t& count)
+{
+    static const AllocationKind kinds[] = {
+        {"EngineBot", []() { return std::unique_ptr<UnoPlayer>(new EngineBot()); }},
+        {"RandomBot", []() { return std::unique_ptr<UnoPlayer>(new RandomBot()); }},
+        {"Player", []() { return std::unique_ptr<UnoPlayer>(new Player()); }},
+    };
+    count = sizeof(kinds) / sizeof(kinds[0]);
+    return kinds;
+}
+
+void runAllocationBenchmarks(BenchmarkRunner &runner)
+{
+    size_t count;
+    const AllocationKind * kinds = allocationKinds(count);
+    for (size_t k = 0; k < count; ++k)
+    {
+        for (int players : {2, 4, 10, 64})
+        {
+            const std::string name = std::string("alloc/sets/") + kinds[k].name 
+                + "/" + std::to_string(players);
+            if (!runner.selected(name)) continue;
+            const SetAllocations measured = measureSets(kinds[k].factory, players, 50, 1000);
+            BenchmarkResult result = {name, measured.sets, 0, 0, 0, 0, {}};
+            result.counters = {
+                {"allocations_per_set", double(measured.allocations) / measured.sets},
+                {"allocations_per_turn", double(measured.allocations) / measured.turns},
+                {"bytes_per_set", double(measured.bytes) / measured.sets},
+            };
+            runner.add(result);
+        }
+    }
+}
+
+bool checkZeroAllocationSets(std::ostream &log)
+{
+    bool passed = true;
+    for (int players : {2, 4, 10, 64})
+    {
+        const SetAllocations measured = measureSets(
+            []() { return std::unique_ptr<UnoPlayer>(new EngineBot()); }, players, 50, 1000);
+        log << "EngineBot/" << players << ": " << measured.allocations 
+            << " allocations in " << measured.sets << " sets\n";
+        if (measured.allocations != 0) passed = false;
+    }
+    return passed;
+}
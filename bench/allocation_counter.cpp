@@ -0,0 +1,87 @@
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<std::uint64_t> allocations(0);
+static std::atomic<std::uint64_t> bytes(0);
+
+std::uint64_t allocationCount() { return allocations.load(std::memory_order_relaxed); }
+std::uint64_t allocatedBytes() { return bytes.load(std::memory_order_relaxed); }
+
+static void * countedAllocate(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+static void * countedAllocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+#if defined(_WIN32)
+    return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    void * pointer = nullptr;
+    if (posix_memalign(&pointer, align, size == 0 ? 1 : size) != 0) return nullptr;
+    return pointer;
+#endif
+}
+
+static void releaseAligned(void * pointer)
+{
+#if defined(_WIN32)
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+void * operator new(std::size_t size)
+{
+    void * pointer = countedAllocate(size);
+    if (pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+}
+
+void * operator new[](std::size_t size)
+{
+    void * pointer = countedAllocate(size);
+    if (pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+}
+
+void * operator new(std::size_t size, const std::nothrow_t&) noexcept
+    { return countedAllocate(size); }
+void * operator new[](std::size_t size, const std::nothrow_t&) noexcept
+    { return countedAllocate(size); }
+
+void * operator new(std::size_t size, std::align_val_t alignment)
+{
+    void * pointer = countedAllocateAligned(size, alignment);
+    if (pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+}
+
+void * operator new[](std::size_t size, std::align_val_t alignment)
+{
+    void * pointer = countedAllocateAligned(size, alignment);
+    if (pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+}
+
+void operator delete(void * pointer) noexcept { std::free(pointer); }
+void operator delete[](void * pointer) noexcept { std::free(pointer); }
+void operator delete(void * pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void * pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void * pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void * pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete(void * pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete[](void * pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete(void * pointer, std::size_t, std::align_val_t) noexcept
+    { releaseAligned(pointer); }
+void operator delete[](void * pointer, std::size_t, std::align_val_t) noexcept
+    { releaseAligned(pointer); }
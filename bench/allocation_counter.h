@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Подсчет выделений памяти. Файл allocation_counter.cpp заменяет глобальные
+ * operator new и operator delete, поэтому подключается только к бенчмаркам.
+*/
+
+/// @return число вызовов operator new с начала программы во всех потоках.
+std::uint64_t allocationCount();
+
+/// @return сколько байт запрошено у operator new с начала программы.
+std::uint64_t allocatedBytes();
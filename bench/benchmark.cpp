@@ -0,0 +1,96 @@
+#include "benchmark.h"
+
+#include <ctime>
+#include <thread>
+
+BenchmarkRunner::BenchmarkRunner(
+    double minTime, const std::string &filter, std::ostream *progress):
+    minTime(minTime), filter(filter), results(), progress(progress)
+{}
+
+void BenchmarkRunner::record(
+    const std::string &name, std::uint64_t iterations,
+    std::uint64_t wall, std::uint64_t cpu,
+    double itemsPerIteration, double bytesPerIteration)
+{
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.realTime = static_cast<double>(wall) / iterations;
+    result.cpuTime = static_cast<double>(cpu) / iterations;
+    const double seconds = wall > 0 ? wall * 1e-9 : 1e-9;
+    result.itemsPerSecond = itemsPerIteration * iterations / seconds;
+    result.bytesPerSecond = bytesPerIteration * iterations / seconds;
+    results.push_back(result);
+    if (progress != nullptr)
+        *progress << name << '\t' << result.realTime << " ns\t"
+            << result.itemsPerSecond << " items/s" << std::endl;
+}
+
+void BenchmarkRunner::add(const BenchmarkResult &result)
+{
+    if (!selected(result.name)) return;
+    results.push_back(result);
+    if (progress != nullptr)
+    {
+        *progress << result.name;
+        for (const auto& counter : result.counters)
+            *progress << '\t' << counter.first << '=' << counter.second;
+        *progress << std::endl;
+    }
+}
+
+/// @brief Записывает строку JSON; имена бенчмарков не содержат символов,
+/// которые нужно экранировать, кроме кавычек и обратной косой черты.
+static void writeString(std::ostream& out, const std::string& value)
+{
+    out << '"';
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+    out << '"';
+}
+
+void BenchmarkRunner::writeJSON(std::ostream &out) const
+{
+    char date[32] = "";
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    out << "    \"library_build_type\": \"release\",\n";
+#else
+    out << "    \"library_build_type\": \"debug\",\n";
+#endif
+#ifdef UNO_PROFILE
+    out << "    \"uno_profile\": true\n";
+#else
+    out << "    \"uno_profile\": false\n";
+#endif
+    out << "  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        writeString(out, result.name);
+        out << ", \"run_type\": \"iteration\", \"iterations\": " << result.iterations
+            << ", \"real_time\": " << result.realTime
+            << ", \"cpu_time\": " << result.cpuTime
+            << ", \"time_unit\": \"ns\", \"items_per_second\": " << result.itemsPerSecond;
+        if (result.bytesPerSecond > 0)
+            out << ", \"bytes_per_second\": " << result.bytesPerSecond;
+        for (const auto& counter : result.counters)
+        {
+            out << ", ";
+            writeString(out, counter.first);
+            out << ": " << counter.second;
+        }
+        out << '}';
+    }
+    out << "\n  ]\n}\n";
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "decision_timer.h"
+
+/// @brief Не дает компилятору выбросить вычисление `value`.
+template<class T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void * volatile sink;
+    sink = &value;
+#endif
+}
+
+/// @brief Результат бенчмарка; время — на одно повторение, нс.
+struct BenchmarkResult
+{
+    std::string name;
+    std::uint64_t iterations;
+    double realTime, cpuTime;
+    /// @brief Обработано элементов и байт в секунду (0 — не считается).
+    double itemsPerSecond, bytesPerSecond;
+    /// @brief Дополнительные показатели, выводятся отдельными полями.
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+/**
+ * @brief Запуск бенчмарков и вывод результатов в JSON.
+ * @details Тело бенчмарка `body(iterations)` выполняет заданное число
+ * повторений. Число повторений удваивается (с оценкой по прошлому
+ * замеру), пока замер не продлится не меньше `minTime` секунд; в результат
+ * идет последний замер. Формат вывода совместим с Google Benchmark
+ * (`--benchmark_format=json`), так что результаты разных версий можно
+ * сравнивать его инструментами.
+*/
+class BenchmarkRunner
+{
+    double minTime;
+    std::string filter;
+    std::vector<BenchmarkResult> results;
+    std::ostream * progress;
+
+    void record(
+        const std::string& name, std::uint64_t iterations,
+        std::uint64_t wall, std::uint64_t cpu,
+        double itemsPerIteration, double bytesPerIteration);
+
+public:
+    /// @param minTime наименьшая длительность замера, с.
+    /// @param filter запускаются только бенчмарки, в имени которых есть
+    /// эта подстрока.
+    /// @param progress поток для вывода хода работы или nullptr.
+    BenchmarkRunner(double minTime, const std::string& filter, std::ostream * progress);
+
+    /// @return true, если бенчмарк `name` нужно запустить.
+    bool selected(const std::string& name) const
+        { return name.find(filter) != std::string::npos; }
+
+    /// @param itemsPerIteration сколько элементов обрабатывает повторение.
+    /// @param bytesPerIteration сколько байт обрабатывает повторение.
+    template<class F>
+    void run(
+        const std::string& name, F body,
+        double itemsPerIteration = 1, double bytesPerIteration = 0)
+    {
+        if (!selected(name)) return;
+        std::uint64_t iterations = 1;
+        while (true)
+        {
+            const std::uint64_t wallStart = wallClockNanoseconds();
+            const std::uint64_t cpuStart = threadCpuNanoseconds();
+            body(iterations);
+            const std::uint64_t cpu = threadCpuNanoseconds() - cpuStart;
+            const std::uint64_t wall = wallClockNanoseconds() - wallStart;
+            const double seconds = wall * 1e-9;
+            if (seconds >= minTime || iterations >= (std::uint64_t(1) << 40))
+            {
+                record(name, iterations, wall, cpu, itemsPerIteration, bytesPerIteration);
+                return;
+            }
+            // Целимся чуть дальше minTime, но не больше чем в 10 раз за шаг
+            double factor = seconds > 0 ? minTime * 1.4 / seconds : 10;
+            if (factor > 10) factor = 10;
+            if (factor < 2) factor = 2;
+            iterations = static_cast<std::uint64_t>(iterations * factor);
+        }
+    }
+
+    /// @brief Добавляет результат, измеренный без `run`, если бенчмарк
+    /// выбран фильтром.
+    void add(const BenchmarkResult& result);
+
+    const std::vector<BenchmarkResult>& getResults() const { return results; }
+
+    void writeJSON(std::ostream& out) const;
+};
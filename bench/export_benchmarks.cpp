@@ -0,0 +1,88 @@
+#include "suites.h"
+
+#include <cstring>
+#include <ostream>
+#include <random>
+#include <streambuf>
+#include <vector>
+
+#include "export.h"
+
+/// @brief Буфер потока, копирующий записанные байты в память; память
+/// переиспользуется после `rewind()`.
+class MemoryBuffer: public std::streambuf
+{
+    std::vector<char> storage;
+    size_t used;
+
+    void append(const char * data, size_t size)
+    {
+        if (used + size > storage.size()) storage.resize(2 * (used + size));
+        std::memcpy(storage.data() + used, data, size);
+        used += size;
+    }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            const char value = traits_type::to_char_type(c);
+            append(&value, 1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char * data, std::streamsize size) override
+    {
+        append(data, static_cast<size_t>(size));
+        return size;
+    }
+
+public:
+    MemoryBuffer(): storage(), used(0) {}
+    std::uint64_t written() const { return used; }
+    void rewind() { used = 0; }
+};
+
+void runExportBenchmarks(BenchmarkRunner &runner)
+{
+    if (!runner.selected("export/text") && !runner.selected("export/binary")) return;
+
+    const int players = 4;
+    const int games = 1 << 20;
+    GameResults results(players);
+    results.reserve(games);
+    std::mt19937 engine(42);
+    std::uniform_int_distribution<int> winner(0, players - 1), score(0, 600);
+    for (int g = 0; g < games; ++g)
+    {
+        int scores[players];
+        for (int& s : scores) s = score(engine);
+        results.add(winner(engine), scores, 1 + g % 12, 40 + g % 500);
+    }
+
+    // Размер выгрузки заранее, чтобы считать байты в секунду
+    auto size = [&](void (*exporter)(const GameResults&, std::ostream&)) {
+        MemoryBuffer buffer;
+        std::ostream out(&buffer);
+        exporter(results, out);
+        return static_cast<double>(buffer.written());
+    };
+    auto text = [](const GameResults& r, std::ostream& out) { exportResultsText(r, out); };
+    auto binary = [](const GameResults& r, std::ostream& out) { exportResultsBinary(r, out); };
+
+    for (auto exporter : {std::make_pair("export/text", +text), std::make_pair("export/binary", +binary)})
+    {
+        runner.run(exporter.first, [&](std::uint64_t iterations) {
+            MemoryBuffer buffer;
+            std::ostream out(&buffer);
+            for (std::uint64_t i = 0; i < iterations; ++i) 
+            {
+                buffer.rewind();
+                exporter.second(results, out);
+            }
+            doNotOptimize(buffer.written());
+        }, games, size(exporter.second));
+    }
+}
@@ -0,0 +1,89 @@
+#include "suites.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "uno_game.h"
+#include "house_rules_game.h"
+#include "RandomBot.h"
+#include "Pudge_player.h"
+
+/// @brief Стол из `players` одинаковых игроков.
+template<class Game = UnoGame>
+struct Table
+{
+    Game game;
+    std::vector<std::unique_ptr<UnoPlayer>> seats;
+
+    /// @param args аргументы конструктора игры.
+    template<class... Args>
+    Table(const PlayerFactory& factory, int players, Args&&... args):
+        game(std::forward<Args>(args)...)
+    {
+        game.setRandomGeneratorSeed(42);
+        for (int i = 0; i < players; ++i)
+        {
+            seats.push_back(factory());
+            game.addPlayer(seats.back().get());
+        }
+    }
+};
+
+/// @brief Замеряет партии игры `Game` за столом из `players` игроков.
+template<class Game, class... Args>
+static void runSets(BenchmarkRunner &runner, const std::string& name, 
+    const PlayerFactory& factory, int players, const Args&... args)
+{
+    runner.run(name, [&](std::uint64_t iterations) {
+        Table<Game> table(factory, players, args...);
+        table.game.initPlayerInfo();
+        for (std::uint64_t i = 0; i < iterations; ++i)
+            doNotOptimize(table.game.runSet());
+    });
+}
+
+void runMacroBenchmarks(BenchmarkRunner &runner)
+{
+    struct Kind
+    {
+        const char * name;
+        PlayerFactory factory;
+    };
+    const Kind kinds[] = {
+        {"RandomBot", []() { return std::unique_ptr<UnoPlayer>(new RandomBot()); }},
+        {"Player", []() { return std::unique_ptr<UnoPlayer>(new Player()); }},
+    };
+    for (const Kind& kind : kinds)
+    {
+        for (int players : {2, 4, 10})
+        {
+            const std::string suffix = std::string(kind.name) + "/" + std::to_string(players);
+            runner.run("macro/sets/" + suffix, [&](std::uint64_t iterations) {
+                Table<> table(kind.factory, players);
+                table.game.initPlayerInfo();
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                    doNotOptimize(table.game.runSet());
+            });
+            runner.run("macro/games/" + suffix, [&](std::uint64_t iterations) {
+                Table<> table(kind.factory, players);
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                    doNotOptimize(table.game.runGame());
+            });
+        }
+        // Большой стол: несколько колод
+        runSets<UnoGame>(runner, std::string("macro/sets/") + kind.name + "/64", 
+            kind.factory, 64, GameConfig::forTable(64));
+        // Партии по домашним правилам
+        const std::string rules = std::string("macro/sets/rules/");
+        const std::string suffix = std::string("/") + kind.name + "/4";
+        runSets<HouseRulesGame<StandardRules>>(runner, rules + "standard" + suffix, kind.factory, 4);
+        runSets<HouseRulesGame<StackingRules>>(runner, rules + "stacking" + suffix, kind.factory, 4);
+        runSets<HouseRulesGame<JumpInRules>>(runner, rules + "jumpIn" + suffix, kind.factory, 4);
+        runSets<HouseRulesGame<SevenZeroRules>>(runner, rules + "sevenZero" + suffix, kind.factory, 4);
+        runSets<HouseRulesGame<DrawUntilPlayableRules>>(runner, 
+            rules + "drawUntilPlayable" + suffix, kind.factory, 4);
+        runSets<HouseRulesGame<AllHouseRules>>(runner, rules + "all" + suffix, kind.factory, 4);
+    }
+}
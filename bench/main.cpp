@@ -0,0 +1,61 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "suites.h"
+
+static void printUsage(const char * program)
+{
+    std::cerr << "Usage: " << program
+        << " [--filter=SUBSTRING] [--min-time=SECONDS] [--out=FILE]\n"
+        << "       " << program << " --check-allocations\n"
+        << "Runs the benchmarks whose names contain SUBSTRING and writes\n"
+        << "the results as JSON to FILE (standard output by default).\n"
+        << "--check-allocations fails if a warmed-up set allocates memory.\n";
+}
+
+int main(int argc, char ** argv)
+{
+    std::string filter, output;
+    double minTime = 0.5;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        auto value = [&](const char * option) {
+            return argument.substr(std::strlen(option));
+        };
+        if (argument.rfind("--filter=", 0) == 0) filter = value("--filter=");
+        else if (argument.rfind("--min-time=", 0) == 0) 
+            minTime = std::atof(value("--min-time=").c_str());
+        else if (argument.rfind("--out=", 0) == 0) output = value("--out=");
+        else if (argument == "--check-allocations") 
+            return checkZeroAllocationSets(std::cerr) ? 0 : 1;
+        else
+        {
+            printUsage(argv[0]);
+            return argument == "--help" ? 0 : 1;
+        }
+    }
+
+    BenchmarkRunner runner(minTime, filter, &std::cerr);
+    runMicroBenchmarks(runner);
+    runMacroBenchmarks(runner);
+    runExportBenchmarks(runner);
+    runAllocationBenchmarks(runner);
+
+    if (output.empty())
+    {
+        runner.writeJSON(std::cout);
+        return 0;
+    }
+    std::ofstream out(output);
+    if (!out)
+    {
+        std::cerr << "Cannot open " << output << '\n';
+        return 1;
+    }
+    runner.writeJSON(out);
+    return 0;
+}
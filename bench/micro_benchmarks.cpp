@@ -0,0 +1,211 @@
+#include "suites.h"
+
+#include <memory>
+#include <string>
+
+#include "uno_game.h"
+#include "RandomBot.h"
+
+/// @brief Игра, которая выдает карты из начала колоды через chooseCards:
+/// выбранные карты приходится искать и убирать из середины колоды.
+class FrontDealGame: public UnoGame
+{
+protected:
+    std::vector<const Card*> chooseCards(const UnoPlayer* player, int numberOfCards) override
+    {
+        return std::vector<const Card*>(
+            getDeck().begin(), getDeck().begin() + numberOfCards);
+    }
+};
+
+/// @brief Доступ бенчмарков к служебным методам игры.
+class UnoGameBenchmark
+{
+    std::unique_ptr<UnoGame> owned;
+    UnoGame& game;
+    std::vector<std::unique_ptr<RandomBot>> bots;
+
+public:
+    explicit UnoGameBenchmark(int players, UnoGame * instance = new UnoGame()):
+        owned(instance), game(*instance)
+    {
+        game.setRandomGeneratorSeed(42);
+        for (int i = 0; i < players; ++i)
+        {
+            bots.emplace_back(new RandomBot());
+            game.addPlayer(bots.back().get());
+        }
+        game.shuffleDeck();
+    }
+
+    UnoGame& get() { return game; }
+    UnoPlayer * player(int index) { return bots.at(index).get(); }
+
+    void prepareDeck()
+    {
+        game.clearDeck();
+        game.deck.clear();
+        game.prepareDeck();
+    }
+
+    void shuffleDeck() { game.shuffleDeck(); }
+    int deckSize() const { return game.deck.size(); }
+    const Card * deckCard(int index) const { return game.deck.at(index); }
+
+    std::vector<const Card*> getCardsFromDeck(int playerIndex, int numberOfCards)
+        { return game.getCardsFromDeck(player(playerIndex), numberOfCards); }
+    void moveToDeck() { game.moveToDeck(); }
+
+    void setActivePlayer(int index) { game.activePlayerIndex_ = index; }
+    /// @brief Сажает за стол партии всех игроков.
+    void seatPlayers()
+    {
+        game.setPlayers.assign(game.players.begin(), game.players.end());
+        game.seatSetPlayers();
+    }
+    int nextPlayerIndex() { return game.nextPlayerIndex(); }
+
+    void setColor(CardColor color) { game.currentColor_ = color; }
+    bool canPlaceCard(int playerIndex, const Card * top)
+        { return game.canPlaceCard(player(playerIndex), top); }
+    int countHandScore(int playerIndex) { return game.countHandScore(playerIndex); }
+
+    void broadcastCardPlayed(const Card * card) 
+        { game.broadcaster.handleCardPlayed(0, card); }
+};
+
+void runMicroBenchmarks(BenchmarkRunner &runner)
+{
+    runner.run("micro/prepareDeck", [](std::uint64_t iterations) {
+        // Вместе с освобождением карт предыдущей колоды
+        UnoGameBenchmark bench(2);
+        for (std::uint64_t i = 0; i < iterations; ++i) bench.prepareDeck();
+        doNotOptimize(bench.deckCard(0));
+    }, 108);
+
+    runner.run("micro/shuffleDeck", [](std::uint64_t iterations) {
+        UnoGameBenchmark bench(2);
+        for (std::uint64_t i = 0; i < iterations; ++i) bench.shuffleDeck();
+        doNotOptimize(bench.deckCard(0));
+    }, 108);
+
+    runner.run("micro/getCardsFromDeck/7", [](std::uint64_t iterations) {
+        // Раздаем по 7 карт, пока хватает колоды, затем собираем карты
+        // обратно (доля сбора — одна раздача из 14)
+        UnoGameBenchmark bench(4);
+        int dealt = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            doNotOptimize(bench.getCardsFromDeck(dealt % 4, 7));
+            if (++dealt == 14)
+            {
+                bench.moveToDeck();
+                dealt = 0;
+            }
+        }
+    }, 7);
+
+    runner.run("micro/getCardsFromDeck/chosen/7", [](std::uint64_t iterations) {
+        // То же, но карты выбирает chooseCards (вместе с построением
+        // вектора выбранных карт)
+        UnoGameBenchmark bench(4, new FrontDealGame());
+        int dealt = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            doNotOptimize(bench.getCardsFromDeck(dealt % 4, 7));
+            if (++dealt == 14)
+            {
+                bench.moveToDeck();
+                dealt = 0;
+            }
+        }
+    }, 7);
+
+    for (int players : {4, 64})
+    {
+        // Время не должно зависеть от числа игроков
+        runner.run("micro/nextPlayerIndex/" + std::to_string(players), 
+            [players](std::uint64_t iterations) {
+                UnoGameBenchmark bench(players, new UnoGame(GameConfig::forTable(players)));
+                bench.seatPlayers();
+                int active = 0;
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    bench.setActivePlayer(active);
+                    active = bench.nextPlayerIndex();
+                }
+                doNotOptimize(active);
+            });
+    }
+
+    runner.run("micro/canPlaceCard/7", [](std::uint64_t iterations) {
+        UnoGameBenchmark bench(2);
+        bench.getCardsFromDeck(0, 7);
+        // Разные верхние карты и цвета, чтобы ответ не был всегда одним
+        const int variants = 16;
+        const CardColor colors[] = 
+            {CardColor::Blue, CardColor::Green, CardColor::Red, CardColor::Yellow};
+        int placeable = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            const int k = i % variants;
+            bench.setColor(colors[k % 4]);
+            placeable += bench.canPlaceCard(0, bench.deckCard(k));
+        }
+        doNotOptimize(placeable);
+    });
+
+    runner.run("micro/countHandScore/7", [](std::uint64_t iterations) {
+        UnoGameBenchmark bench(2);
+        bench.getCardsFromDeck(0, 7);
+        long long sum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i) 
+        {
+            sum += bench.countHandScore(0);
+            doNotOptimize(sum);
+        }
+    });
+
+    // Открытое состояние игроков: копия против диапазона
+    runner.run("micro/numberOfCards/10", [](std::uint64_t iterations) {
+        UnoGameBenchmark bench(10);
+        long long sum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            for (int cards : bench.get().numberOfCards()) sum += cards;
+            doNotOptimize(sum);
+        }
+    });
+
+    runner.run("micro/handSizes/10", [](std::uint64_t iterations) {
+        UnoGameBenchmark bench(10);
+        long long sum = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            for (int cards : bench.get().handSizes()) sum += cards;
+            doNotOptimize(sum);
+        }
+    });
+
+    runner.run("micro/broadcast/4", [](std::uint64_t iterations) {
+        // Рассылка одного события четырем наблюдателям и пустой очереди
+        // сообщений
+        UnoGameBenchmark bench(0);
+        Observer observers[4];
+        for (Observer& observer : observers) bench.get().addObserver(&observer);
+        const Card * card = bench.deckCard(0);
+        for (std::uint64_t i = 0; i < iterations; ++i) bench.broadcastCardPlayed(card);
+        doNotOptimize(card);
+    });
+
+    runner.run("micro/addMessage", [](std::uint64_t iterations) {
+        const int limit = 1024;
+        MessageQueue queue(limit);
+        const std::string message = "Uno!";
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            if (i % limit == 0) queue.clear();
+            doNotOptimize(queue.addMessage(i % 4, message));
+        }
+    });
+}
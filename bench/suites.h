@@ -0,0 +1,28 @@
+#pragma once
+
+#include <ostream>
+
+#include "benchmark.h"
+
+/// @brief Микробенчмарки служебных методов игры: подготовка и перемешивание
+/// колоды, выдача карт, выбор следующего игрока, проверка хода, подсчет очков,
+/// рассылка событий и очередь сообщений.
+void runMicroBenchmarks(BenchmarkRunner& runner);
+
+/// @brief Макробенчмарки: партий и игр в секунду за столами из 2, 4 и 10
+/// игроков RandomBot и Player.
+void runMacroBenchmarks(BenchmarkRunner& runner);
+
+/// @brief Скорость выгрузки результатов игр в текст и двоичный формат, байт
+/// в секунду.
+void runExportBenchmarks(BenchmarkRunner& runner);
+
+/// @brief Выделения памяти на партию и на ход после разогрева за столами
+/// из 2, 4 и 10 игроков EngineBot (не выделяет память сам), RandomBot и
+/// Player.
+void runAllocationBenchmarks(BenchmarkRunner& runner);
+
+/// @brief Проверяет, что партии после разогрева не выделяют память, когда
+/// сами игроки ее не выделяют.
+/// @return true, если выделений не было.
+bool checkZeroAllocationSets(std::ostream& log);
@@ -0,0 +1,29 @@
+#include "arena.h"
+
+SetArena::SetArena(size_t blockSize):
+    blocks(), current(0), offset(0), blockSize(blockSize), used(0)
+{}
+
+void * SetArena::allocateSlow(size_t bytes, size_t alignment)
+{
+    // Блоки, оставшиеся от прошлых партий
+    while (current + 1 < blocks.size())
+    {
+        ++current;
+        offset = 0;
+        void * pointer = tryAllocate(bytes, alignment);
+        if (pointer != nullptr) return pointer;
+    }
+    const size_t size = bytes + alignment > blockSize ? bytes + alignment : blockSize;
+    blocks.push_back(Block{std::unique_ptr<char[]>(new char[size]), size});
+    current = blocks.size() - 1;
+    offset = 0;
+    return tryAllocate(bytes, alignment);
+}
+
+size_t SetArena::capacity() const
+{
+    size_t total = 0;
+    for (const Block& block : blocks) total += block.size;
+    return total;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Монотонная арена памяти партии.
+ * @details Память выдается подряд из больших блоков и не освобождается по
+ * отдельности: вся арена очищается методом `reset()` в начале каждой партии
+ * (до события SetStarted). Блоки при этом сохраняются, так что после первых
+ * партий арена не обращается к куче. У каждой игры своя арена, поэтому в
+ * параллельных прогонах потоки не делят глобальный распределитель.
+*/
+class SetArena
+{
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    /// @brief Номер текущего блока.
+    size_t current;
+    /// @brief Сколько байт текущего блока занято.
+    size_t offset;
+    size_t blockSize;
+    size_t used;
+
+    /// @return адрес в текущем блоке, выровненный на `alignment`, или
+    /// nullptr, если `bytes` байт в блоке не помещаются.
+    void * tryAllocate(size_t bytes, size_t alignment)
+    {
+        if (current >= blocks.size()) return nullptr;
+        Block& block = blocks[current];
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        const std::uintptr_t address = (base + offset + alignment - 1) & ~(alignment - 1);
+        const size_t end = address - base + bytes;
+        if (end > block.size) return nullptr;
+        offset = end;
+        used += bytes;
+        return reinterpret_cast<void*>(address);
+    }
+
+    /// @brief Переходит к следующему подходящему блоку или выделяет новый.
+    void * allocateSlow(size_t bytes, size_t alignment);
+
+public:
+    /// @param blockSize размер блока, байт; большие запросы получают 
+    /// отдельный блок нужного размера.
+    explicit SetArena(size_t blockSize = 64 * 1024);
+
+    SetArena(const SetArena&) = delete;
+    SetArena& operator=(const SetArena&) = delete;
+
+    /// @param alignment степень двойки.
+    void * allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        void * pointer = tryAllocate(bytes, alignment);
+        return pointer != nullptr ? pointer : allocateSlow(bytes, alignment);
+    }
+
+    /// @brief Делает всю выданную память свободной.
+    void reset() { current = 0; offset = 0; used = 0; }
+
+    /// @return сколько байт выдано с последнего `reset()`.
+    size_t bytesUsed() const { return used; }
+    /// @return суммарный размер блоков.
+    size_t capacity() const;
+};
+
+/**
+ * @brief Распределитель для стандартных контейнеров, берущий память из
+ * арены партии; освобождение ничего не делает.
+ * @details Без арены (nullptr) работает как обычный распределитель, так что
+ * игрок, не добавленный в игру, может пользоваться теми же контейнерами.
+ * Контейнеры на арене нельзя хранить дольше партии.
+*/
+template<class T>
+class ArenaAllocator
+{
+    template<class U> friend class ArenaAllocator;
+
+    SetArena * arena;
+
+public:
+    using value_type = T;
+
+    ArenaAllocator(SetArena * arena = nullptr) noexcept: arena(arena) {}
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept: arena(other.arena) {}
+
+    T * allocate(size_t n)
+    {
+        if (arena == nullptr) return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T * pointer, size_t) noexcept
+    {
+        if (arena == nullptr) ::operator delete(pointer);
+    }
+
+    template<class U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template<class U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template<class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
@@ -10,4 +10,11 @@ bool Card::is_action() const
 int Card::getScore() const
 {
     return is_wild() ? WILD_CARD_SCORE : is_action() ? ACTION_CARD_SCORE : value;
+}
+
+int Card::kind() const
+{
+    if (value == CardValue::Wild) return NUMBER_OF_CARD_KINDS - 2;
+    if (value == CardValue::WildDraw4) return NUMBER_OF_CARD_KINDS - 1;
+    return color * 13 + value;
 }
\ No newline at end of file
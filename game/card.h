@@ -17,6 +17,10 @@ enum CardValue
     WildDraw4 = 14, // Возьми 4
 };
 
+/// @brief Количество различных видов карт: 13 значений для каждого из 4 цветов
+/// и две дикие карты.
+const int NUMBER_OF_CARD_KINDS = 54;
+
 /// @brief Представление карты
 struct Card
 {
@@ -32,8 +36,11 @@ struct Card
      * иначе используется значение enum CardValue.
     */
     int value;
+    /// @brief Номер карты в игре, от 0 до числа ее карт; у карт, созданных
+    /// не игрой, −1.
+    int id;
 
-    Card(CardColor color, int value): color(color), value(value) {}
+    Card(CardColor color, int value, int id = -1): color(color), value(value), id(id) {}
 
     /// @return является ли карта корректной
     bool is_valid() const { return 0 <= value && value <= CardValue::WildDraw4; }
@@ -50,4 +57,10 @@ struct Card
     /// стоимость 20 очков, карты с цифрами имеют стоимость, соответствующую 
     /// их цифре.
     int getScore() const;
+
+    /// @brief Возвращает вид карты — номер в диапазоне [0; NUMBER_OF_CARD_KINDS).
+    /// @details Для карт, не являющихся дикими, вид равен `color * 13 + value`,
+    /// "Закажи цвет" имеет вид 52, "Возьми 4" — 53. Цвет дикой карты не 
+    /// учитывается.
+    int kind() const;
 };
@@ -0,0 +1,49 @@
+#include "decision_timer.h"
+
+#include <chrono>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+std::uint64_t wallClockNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::uint64_t threadCpuNanoseconds()
+{
+#if defined(_WIN32)
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+        return 0;
+    // Время в единицах по 100 нс
+    ULARGE_INTEGER k, u;
+    k.LowPart = kernel.dwLowDateTime;
+    k.HighPart = kernel.dwHighDateTime;
+    u.LowPart = user.dwLowDateTime;
+    u.HighPart = user.dwHighDateTime;
+    return (k.QuadPart + u.QuadPart) * 100;
+#else
+    timespec time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) return 0;
+    return static_cast<std::uint64_t>(time.tv_sec) * 1000000000u + time.tv_nsec;
+#endif
+}
+
+void DecisionLatency::merge(const DecisionLatency &other)
+{
+    wall.merge(other.wall);
+    cpu.merge(other.cpu);
+    overruns += other.overruns;
+}
+
+void DecisionLatency::clear()
+{
+    wall.clear();
+    cpu.clear();
+    overruns = 0;
+}
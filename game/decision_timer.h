@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+#include "../utils/histogram.h"
+
+/// @return показание монотонных часов в наносекундах.
+std::uint64_t wallClockNanoseconds();
+
+/// @return процессорное время текущего потока в наносекундах.
+std::uint64_t threadCpuNanoseconds();
+
+/**
+ * @brief Ограничения времени решений игрока.
+ * @details Время решения — время одного вызова playCard, drawAdditionalCard
+ * или changeColor. Значение 0 означает отсутствие ограничения.
+*/
+struct DecisionBudget
+{
+    /// @brief Наибольшее время одного решения, нс.
+    std::uint64_t perDecision = 0;
+    /// @brief Наибольшее суммарное время решений игрока за игру, нс.
+    std::uint64_t perGame = 0;
+    /// @brief Ограничивать процессорное время потока, а не время по часам.
+    bool cpuTime = false;
+
+    bool limited() const { return perDecision != 0 || perGame != 0; }
+};
+
+/// @brief Распределения времени решений одного игрока.
+struct DecisionLatency
+{
+    /// @brief Время решений по часам и процессорное время потока, нс.
+    LogLinearHistogram wall, cpu;
+    /// @brief Число решений, превысивших ограничение.
+    std::uint64_t overruns;
+
+    DecisionLatency(): wall(5, 40), cpu(5, 40), overruns(0) {}
+
+    void merge(const DecisionLatency& other);
+    void clear();
+};
@@ -0,0 +1,43 @@
+#include "deck.h"
+
+void Deck::reserve(size_t numberOfCards)
+{
+    cards_.reserve(numberOfCards);
+    if (positions.size() < numberOfCards) positions.resize(numberOfCards, -1);
+}
+
+bool Deck::remove(const Card *card)
+{
+    if (!contains(card)) return false;
+    const int position = positions[card->id];
+    const Card * last = cards_.back();
+    cards_[position] = last;
+    positions[last->id] = position;
+    cards_.pop_back();
+    positions[card->id] = -1;
+    return true;
+}
+
+void Deck::sortById()
+{
+    std::sort(cards_.begin(), cards_.end(), 
+        [](const Card * a, const Card * b) { return a->id < b->id; });
+    for (size_t i = 0; i < cards_.size(); ++i) positions[cards_[i]->id] = i;
+}
+
+void Deck::clear()
+{
+    // Карты не разыменовываются: их могли уже удалить
+    std::fill(positions.begin(), positions.end(), -1);
+    cards_.clear();
+}
+
+bool Deck::isConsistent() const
+{
+    size_t indexed = 0;
+    for (int position : positions) indexed += position >= 0;
+    if (indexed != cards_.size()) return false;
+    for (size_t i = 0; i < cards_.size(); ++i)
+        if (positions[cards_[i]->id] != static_cast<int>(i)) return false;
+    return true;
+}
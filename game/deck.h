@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "card.h"
+
+/**
+ * @brief Колода: массив карт и обратный индекс "номер карты → позиция в
+ * массиве".
+ * @details Индекс позволяет за O(1) проверить, лежит ли карта в колоде, и
+ * убрать из колоды произвольную карту (на ее место встает последняя). Карты
+ * должны иметь номера `Card::id`, которые раздает игра; карты с чужими
+ * номерами (или созданные не игрой) считаются отсутствующими в колоде.
+ * Карты берутся с конца массива.
+*/
+class Deck
+{
+    std::vector<const Card *> cards_;
+    /// @brief positions[id] — позиция карты в cards_ или -1.
+    std::vector<int> positions;
+
+    void place(const Card * card, size_t position)
+    {
+        if (static_cast<size_t>(card->id) >= positions.size())
+            positions.resize(card->id + 1, -1);
+        positions[card->id] = static_cast<int>(position);
+    }
+
+public:
+    Deck(): cards_(), positions() {}
+
+    /// @brief Выделяет место под `numberOfCards` карт с номерами от 0 до
+    /// `numberOfCards` − 1.
+    void reserve(size_t numberOfCards);
+
+    const std::vector<const Card *>& cards() const { return cards_; }
+    size_t size() const { return cards_.size(); }
+    bool empty() const { return cards_.empty(); }
+    const Card * back() const { return cards_.back(); }
+    const Card * at(size_t i) const { return cards_.at(i); }
+
+    std::vector<const Card *>::const_iterator begin() const { return cards_.begin(); }
+    std::vector<const Card *>::const_iterator end() const { return cards_.end(); }
+
+    /// @return true, если карта `card` лежит в колоде.
+    bool contains(const Card * card) const
+    {
+        return card != nullptr
+            && card->id >= 0
+            && static_cast<size_t>(card->id) < positions.size()
+            && positions[card->id] >= 0
+            && cards_[positions[card->id]] == card;
+    }
+
+    void push_back(const Card * card)
+    {
+        place(card, cards_.size());
+        cards_.push_back(card);
+    }
+
+    template<class iterator>
+    void append(iterator begin, iterator end)
+    {
+        for (; begin != end; ++begin) push_back(*begin);
+    }
+
+    /// @brief Убирает `numberOfCards` последних карт.
+    void popBack(size_t numberOfCards = 1)
+    {
+        for (size_t i = cards_.size() - numberOfCards; i < cards_.size(); ++i)
+            positions[cards_[i]->id] = -1;
+        cards_.resize(cards_.size() - numberOfCards);
+    }
+
+    /// @brief Убирает карту `card` из колоды за O(1); на ее место встает
+    /// последняя карта.
+    /// @return false, если карты в колоде нет.
+    bool remove(const Card * card);
+
+    /// @brief Перемешивает колоду и обновляет индекс.
+    template<class random_engine>
+    void shuffle(random_engine& engine)
+    {
+        std::shuffle(cards_.begin(), cards_.end(), engine);
+        for (size_t i = 0; i < cards_.size(); ++i) positions[cards_[i]->id] = i;
+    }
+
+    /// @brief Упорядочивает колоду по номерам карт и обновляет индекс.
+    void sortById();
+
+    /// @brief Убирает все карты, не обращаясь к ним.
+    void clear();
+
+    /// @return true, если индекс соответствует массиву карт (каждая карта
+    /// лежит в колоде один раз).
+    bool isConsistent() const;
+};
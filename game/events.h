@@ -13,6 +13,14 @@ enum GameDirection
     Inverse = 1,
 };
 
+/// @brief Решение, которое игра запрашивает у игрока.
+enum DecisionType
+{
+    PlayCard           = 0, // UnoPlayer::playCard
+    DrawAdditionalCard = 1, // UnoPlayer::drawAdditionalCard
+    ChangeColor        = 2, // UnoPlayer::changeColor
+};
+
 /**
  * @brief Наблюдатель — сущность, которая может реагировать на игровые события.
  * С каждым игровым событием связан метод класса, который будет вызван для
@@ -108,6 +116,17 @@ public:
     /// его можно определить однозначно, иначе -1.
     /// @param winnerScore наибольшее количество очков среди игроков.
     virtual void handleSetsLimitReached(int winnerIndex, int winnerScore) {}
+
+    /// @brief Событие 18. Игроки поменялись картами на руках (правило 7-0,
+    /// @see HouseRules ).
+    /// @param firstPlayer номер первого игрока в списке.
+    /// @param secondPlayer номер второго игрока в списке.
+    virtual void handleHandsSwapped(int firstPlayer, int secondPlayer) {}
+
+    /// @brief Событие 19. Каждый игрок партии передал свою руку следующему
+    /// по направлению игроку (правило 7-0, @see HouseRules ).
+    /// @param direction направление, в котором переданы руки.
+    virtual void handleHandsRotated(GameDirection direction) {}
 };
 
 /// @brief Игровые события, соответствуют методам класса Observer
@@ -130,6 +149,8 @@ enum GameEvent
     MessageOverflow,
     TurnsLimitReached,
     SetsLimitReached,
+    HandsSwapped,
+    HandsRotated,
 };
 
 /**/ 
@@ -183,6 +204,8 @@ public:
     virtual void handleMessageOverflow();
     virtual void handleTurnsLimitReached();
     virtual void handleSetsLimitReached(int winnerIndex, int winnerScore);
+    virtual void handleHandsSwapped(int firstPlayer, int secondPlayer);
+    virtual void handleHandsRotated(GameDirection direction);
 };
 
 template <class iterator>
@@ -338,3 +361,21 @@ inline void Broadcaster<iterator>::handleSetsLimitReached(int winnerIndex, int w
         (*it)->handleSetsLimitReached(winnerIndex, winnerScore);
     afterEach(GameEvent::SetsLimitReached);
 }
+
+template <class iterator>
+inline void Broadcaster<iterator>::handleHandsSwapped(int firstPlayer, int secondPlayer)
+{
+    beforeEach(GameEvent::HandsSwapped);
+    for (auto it = begin(); it != end(); ++it)
+        (*it)->handleHandsSwapped(firstPlayer, secondPlayer);
+    afterEach(GameEvent::HandsSwapped);
+}
+
+template <class iterator>
+inline void Broadcaster<iterator>::handleHandsRotated(GameDirection direction)
+{
+    beforeEach(GameEvent::HandsRotated);
+    for (auto it = begin(); it != end(); ++it)
+        (*it)->handleHandsRotated(direction);
+    afterEach(GameEvent::HandsRotated);
+}
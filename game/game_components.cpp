@@ -1,10 +1,14 @@
 #include "game_components.h"
 
+#include <algorithm>
+
 MessageQueue::MessageQueue(int maximumCapacity): 
     maximumCapacity(maximumCapacity), 
     queue(),
-    overflow(false)
+    overflow(false),
+    arena(nullptr)
 {
+    reserve();
 }
 
 bool MessageQueue::addMessage(int playerIndex, const std::string &message)
@@ -14,13 +18,23 @@ bool MessageQueue::addMessage(int playerIndex, const std::string &message)
         overflow = true;
         return false;
     }
-    queue.push_back(std::make_tuple(playerIndex, message));
+    queue.emplace_back(
+        playerIndex, 
+        ArenaString(message.data(), message.size(), ArenaAllocator<char>(arena)));
     return true;
 }
 
+void MessageQueue::reserve()
+{
+    if (maximumCapacity > 0) 
+        queue.reserve(maximumCapacity < MAX_RESERVED_MESSAGES 
+            ? maximumCapacity : MAX_RESERVED_MESSAGES);
+}
+
 void MessageQueue::setLimit(int newMessageQueueLimit)
 {
     maximumCapacity = newMessageQueueLimit;
+    reserve();
     if (maximumCapacity >= 0 && queue.size() > maximumCapacity) 
         overflow = true;
 }
@@ -1,9 +1,11 @@
 #pragma once
 
-#include <list>
+#include <vector>
 #include <tuple>
 #include <string>
 
+#include "arena.h"
+
 /**
  * @brief Очередь сообщений для игроков. Сюда игроки отправляют свои сообщения,
  * которые потом отображаются наблюдателям.
@@ -12,18 +14,26 @@ class MessageQueue
 {
 public:
     /// @brief Элемент очереди сообщения, хранит номер игрока, отправившего
-    /// сообщение, и само сообщение.
-    using Entry = std::tuple<int, std::string>;
+    /// сообщение, и само сообщение (на арене партии, если она задана).
+    using Entry = std::tuple<int, ArenaString>;
     
     /// @brief Итератор для просмотра очереди сообщений.
-    using const_iterator = std::list<Entry>::const_iterator;
+    using const_iterator = std::vector<Entry>::const_iterator;
 private:
-    /// @brief Массив, хранящий сообщения.
-    std::list<Entry> queue;
+    /// @brief Массив, хранящий сообщения; при ограниченном размере место
+    /// выделяется заранее.
+    std::vector<Entry> queue;
     /// @brief Максимальный размер очереди сообщений. Если < 0, то размер не
     /// ограничивается, но это может привести к бесконечным циклам.
     int maximumCapacity;
     bool overflow;
+    /// @brief Арена для текста сообщений или nullptr.
+    SetArena * arena;
+
+    /// @brief Больше этого числа сообщений место заранее не выделяется.
+    static const int MAX_RESERVED_MESSAGES = 1024;
+    /// @brief Выделяет место под сообщения до ограничения размера.
+    void reserve();
 public:
     MessageQueue(int maximumCapacity);
 
@@ -35,9 +45,13 @@ public:
     bool addMessage(int playerIndex, const std::string& message);
 
     void setLimit(int newMessageQueueLimit);
+    /// @brief Хранить текст сообщений на арене `arena` (nullptr — в куче).
+    void setArena(SetArena * arena) { this->arena = arena; }
     
     const_iterator cbegin() const { return queue.cbegin(); }
     const_iterator cend() const { return queue.cend(); }
+    size_t size() const { return queue.size(); }
+    const Entry& at(size_t i) const { return queue.at(i); }
 
     bool hasOverflow() const { return overflow; }
 
@@ -0,0 +1,56 @@
+#pragma once
+
+/// @brief Размер одной колоды.
+constexpr int STANDARD_DECK_SIZE = 108;
+
+/**
+ * @brief Параметры игры.
+ * @details Литеральный тип: параметры передаются игре во время выполнения
+ * ( @see UnoGame::UnoGame ), а проверить их можно и во время компиляции.
+*/
+struct GameConfig
+{
+    /// @brief Количество очков, необходимое для победы.
+    int winningScore = 500;
+    /// @brief Минимальное количество игроков.
+    int minPlayers = 2;
+    /// @brief Максимальное количество игроков.
+    int maxPlayers = 10;
+    /// @brief Сколько карт изначально раздается игрокам.
+    int initialCards = 7;
+    /// @brief Максимальное количество сообщений в очереди; если < 0, то
+    /// очередь не ограничена.
+    int messageQueueLimit = 50;
+    /// @brief Ограничение на количество ходов в партии; 0 — без ограничения.
+    unsigned turnsLimit = 100000U;
+    /// @brief Ограничение на количество партий в игре; 0 — без ограничения.
+    unsigned setsLimit = 1000;
+    /// @brief Сколько стандартных колод замешано в игре; номера карт
+    /// ( @see Card::id ) различаются и между колодами.
+    int decks = 1;
+
+    /// @return число карт во всех колодах.
+    constexpr int deckSize() const { return decks * STANDARD_DECK_SIZE; }
+
+    /// @return true, если параметры допустимы: хотя бы два игрока, и при
+    /// наибольшем числе игроков после раздачи в колоде остается карта.
+    constexpr bool valid() const
+    {
+        return winningScore > 0
+            && minPlayers >= 2
+            && maxPlayers >= minPlayers
+            && initialCards > 0
+            && decks > 0
+            && initialCards * maxPlayers < deckSize();
+    }
+
+    /// @return параметры по умолчанию для стола до `players` игроков: колод
+    /// берется столько, чтобы после раздачи в колоде остались карты.
+    static constexpr GameConfig forTable(int players)
+    {
+        GameConfig config;
+        if (players > config.maxPlayers) config.maxPlayers = players;
+        config.decks = config.initialCards * config.maxPlayers / STANDARD_DECK_SIZE + 1;
+        return config;
+    }
+};
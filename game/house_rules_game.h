@@ -0,0 +1,23 @@
+#pragma once
+#include "uno_game.h"
+#include "uno_game_impl.h"
+
+/**
+ * @brief Игра по домашним правилам `Rules` ( @see rules.h ) с параметрами,
+ * заданными во время выполнения.
+ * @details Правила подставляются в код партии во время компиляции: каждому
+ * набору правил — своя специализация партии, а стандартная партия UnoGame
+ * остается без проверок домашних правил.
+*/
+template<class Rules>
+class HouseRulesGame: public UnoGame
+{
+protected:
+    std::tuple<int, int> runSet_() override
+    {
+        return runSetImpl<Rules>();
+    }
+
+public:
+    explicit HouseRulesGame(const GameConfig& config = GameConfig()): UnoGame(config) {}
+};
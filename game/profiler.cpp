@@ -0,0 +1,56 @@
+#include "profiler.h"
+
+#include <chrono>
+
+const char * phaseName(SetPhase phase)
+{
+    switch (phase)
+    {
+        case SetPhase::PrepareDeck: return "PrepareDeck";
+        case SetPhase::Deal: return "Deal";
+        case SetPhase::LegalityCheck: return "LegalityCheck";
+        case SetPhase::PlayCard: return "PlayCard";
+        case SetPhase::DrawAdditionalCard: return "DrawAdditionalCard";
+        case SetPhase::ChangeColor: return "ChangeColor";
+        case SetPhase::Broadcast: return "Broadcast";
+        case SetPhase::FlushMessages: return "FlushMessages";
+    }
+    return "Unknown";
+}
+
+double estimateCycleCounterFrequency(double seconds)
+{
+    using clock = std::chrono::steady_clock;
+    const auto begin = clock::now();
+    const std::uint64_t first = readCycleCounter();
+    while (std::chrono::duration<double>(clock::now() - begin).count() < seconds) {}
+    const std::uint64_t last = readCycleCounter();
+    const double elapsed = std::chrono::duration<double>(clock::now() - begin).count();
+    return (last - first) / elapsed;
+}
+
+void PhaseProfile::add(const PhaseProfile &other)
+{
+    for (int i = 0; i < NUMBER_OF_SET_PHASES; ++i)
+    {
+        cycles[i] += other.cycles[i];
+        calls[i] += other.calls[i];
+    }
+}
+
+void PhaseProfile::clear()
+{
+    for (int i = 0; i < NUMBER_OF_SET_PHASES; ++i) cycles[i] = calls[i] = 0;
+}
+
+void PhaseProfile::print(std::ostream &out, double cyclesPerSecond) const
+{
+    out << "Phase\tCalls\tCycles\tNanoseconds\tNanosecondsPerCall\n";
+    for (int i = 0; i < NUMBER_OF_SET_PHASES; ++i)
+    {
+        const double nanoseconds = cycles[i] / cyclesPerSecond * 1e9;
+        out << phaseName(static_cast<SetPhase>(i)) << '\t' << calls[i] << '\t'
+            << cycles[i] << '\t' << nanoseconds << '\t'
+            << (calls[i] == 0 ? 0 : nanoseconds / calls[i]) << '\n';
+    }
+}
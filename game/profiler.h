@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * Инструментирование этапов партии.
+ *
+ * Замеры включаются макросом UNO_PROFILE при компиляции. Без него макрос
+ * UNO_PROFILE_PHASE раскрывается в пустой оператор, и код партии не
+ * меняется. С ним каждый замер — два чтения счетчика тактов и два сложения.
+*/
+
+/// @brief Этапы партии, время которых замеряется.
+enum class SetPhase
+{
+    /// @brief Сбор и перемешивание колоды перед партией.
+    PrepareDeck,
+    /// @brief Выдача карт из колоды.
+    Deal,
+    /// @brief Проверка, может ли игрок положить карту.
+    LegalityCheck,
+    /// @brief Вызовы UnoPlayer::playCard.
+    PlayCard,
+    /// @brief Вызовы UnoPlayer::drawAdditionalCard.
+    DrawAdditionalCard,
+    /// @brief Вызовы UnoPlayer::changeColor.
+    ChangeColor,
+    /// @brief Рассылка событий наблюдателям.
+    Broadcast,
+    /// @brief Рассылка сообщений игроков.
+    FlushMessages,
+};
+
+const int NUMBER_OF_SET_PHASES = 8;
+
+/// @return название этапа.
+const char * phaseName(SetPhase phase);
+
+/// @return показание счетчика тактов процессора (или наносекунд, если
+/// счетчика тактов нет).
+inline std::uint64_t readCycleCounter()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/// @return оценка числа тактов счетчика в секунду, измеренная за `seconds`.
+double estimateCycleCounterFrequency(double seconds = 0.01);
+
+/// @brief Суммарные такты и число замеров по этапам.
+struct PhaseProfile
+{
+    std::uint64_t cycles[NUMBER_OF_SET_PHASES] = {};
+    std::uint64_t calls[NUMBER_OF_SET_PHASES] = {};
+
+    void record(SetPhase phase, std::uint64_t elapsed)
+    {
+        cycles[static_cast<int>(phase)] += elapsed;
+        ++calls[static_cast<int>(phase)];
+    }
+
+    void add(const PhaseProfile& other);
+    void clear();
+
+    /// @brief Печатает этапы в формате TSV: название, число замеров, такты,
+    /// наносекунды (по частоте `cyclesPerSecond`) и наносекунды на замер.
+    void print(std::ostream& out, double cyclesPerSecond) const;
+};
+
+/// @brief Замер: добавляет к профилю время жизни объекта.
+class PhaseProbe
+{
+    PhaseProfile& profile;
+    SetPhase phase;
+    std::uint64_t start;
+
+public:
+    PhaseProbe(PhaseProfile& profile, SetPhase phase):
+        profile(profile), phase(phase), start(readCycleCounter()) {}
+    ~PhaseProbe() { profile.record(phase, readCycleCounter() - start); }
+
+    PhaseProbe(const PhaseProbe&) = delete;
+    PhaseProbe& operator=(const PhaseProbe&) = delete;
+};
+
+#define UNO_PROFILE_CONCAT_(a, b) a##b
+#define UNO_PROFILE_CONCAT(a, b) UNO_PROFILE_CONCAT_(a, b)
+
+#ifdef UNO_PROFILE
+/// @brief Замеряет этап `phase` до конца текущей области видимости.
+#define UNO_PROFILE_PHASE(profile, phase) \
+    PhaseProbe UNO_PROFILE_CONCAT(unoPhaseProbe, __LINE__)(profile, phase)
+#else
+#define UNO_PROFILE_PHASE(profile, phase) ((void)0)
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+
+/**
+ * Правила партии для UnoGame::runSetImpl. Каждое правило — constexpr-флаг
+ * политики, и код выключенных правил не попадает в партию (if constexpr),
+ * так что со StandardRules партия в точности стандартная, без проверок
+ * правил на каждом ходу. У каждого набора правил — своя специализированная
+ * партия.
+*/
+
+/// @brief Стандартные правила: все домашние правила выключены.
+struct StandardRules
+{
+    /// @brief На "Возьми 2" можно положить "Возьми 2", на "Возьми 4" —
+    /// "Возьми 4"; штраф копится и достается первому, кто не добавил к нему
+    /// карту ( @see UnoGame::pendingDraw ).
+    static constexpr bool stacking = false;
+    /// @brief Игрок, у которого есть точно такая же (не дикая) карта, как
+    /// только что положенная, может положить ее вне очереди; игра
+    /// продолжается от него ( @see UnoPlayer::jumpIn ).
+    static constexpr bool jumpIn = false;
+    /// @brief Положивший 7 меняется рукой с выбранным игроком 
+    /// ( @see UnoPlayer::chooseSwapPlayer ), после 0 все руки передаются
+    /// следующему игроку по направлению игры.
+    static constexpr bool sevenZero = false;
+    /// @brief Игрок без подходящей карты тянет карты, пока не вытянет
+    /// подходящую, и решает только про нее.
+    static constexpr bool drawUntilPlayable = false;
+};
+
+/// @brief Набор домашних правил ( @see StandardRules ).
+template<bool Stacking, bool JumpIn, bool SevenZero, bool DrawUntilPlayable>
+struct HouseRules
+{
+    static constexpr bool stacking = Stacking;
+    static constexpr bool jumpIn = JumpIn;
+    static constexpr bool sevenZero = SevenZero;
+    static constexpr bool drawUntilPlayable = DrawUntilPlayable;
+};
+
+using StackingRules = HouseRules<true, false, false, false>;
+using JumpInRules = HouseRules<false, true, false, false>;
+using SevenZeroRules = HouseRules<false, false, true, false>;
+using DrawUntilPlayableRules = HouseRules<false, false, false, true>;
+/// @brief Все домашние правила сразу.
+using AllHouseRules = HouseRules<true, true, true, true>;
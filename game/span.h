@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "card.h"
+
+/**
+ * @brief Непрерывный диапазон элементов без владения (аналог std::span из
+ * C++20).
+ * @details Диапазон действителен, пока не изменен контейнер, на который он
+ * указывает.
+*/
+template<class T>
+class Span
+{
+    T * data_;
+    size_t size_;
+
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using iterator = T *;
+
+    Span() noexcept: data_(nullptr), size_(0) {}
+    Span(T * data, size_t size) noexcept: data_(data), size_(size) {}
+
+    /// @brief Диапазон всех элементов контейнера с методами data() и size().
+    template<class Container, 
+        class = decltype(std::declval<Container&>().data()),
+        class = decltype(std::declval<Container&>().size())>
+    Span(Container& container) noexcept:
+        data_(container.data()), size_(container.size()) {}
+
+    T * data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    iterator begin() const { return data_; }
+    iterator end() const { return data_ + size_; }
+
+    T& operator[](size_t i) const { return data_[i]; }
+    T& front() const { return data_[0]; }
+    T& back() const { return data_[size_ - 1]; }
+};
+
+/// @brief Карты без права изменения диапазона.
+using CardSpan = Span<const Card * const>;
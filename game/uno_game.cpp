@@ -1,13 +1,22 @@
 #include "uno_game.h"
+#include "uno_game_impl.h"
 
 void UnoPlayer::addToGame(
     int playerIndex, 
     const UnoGame *currentGame, 
-    MessageQueue *queue)
+    MessageQueue *queue,
+    SetArena *arena)
 {
     this->currentGame = currentGame;
     this->playerIndex_ = playerIndex;
     this->messageQueue = queue;
+    this->setArena_ = arena;
+}
+
+CardSpan UnoPlayer::myHand() const
+{
+    if (currentGame == nullptr) return CardSpan();
+    return currentGame->playerInfo.at(playerIndex_).hand;
 }
 
 bool UnoPlayer::say(const std::string &message)
@@ -16,26 +25,46 @@ bool UnoPlayer::say(const std::string &message)
     return messageQueue->addMessage(playerIndex(), message);
 }
 
-UnoGame::UnoGame():
-    messageQueue(DEFAULT_MESSAGE_QUEUE_LIMIT),
+UnoGame::UnoGame(const GameConfig& config):
+    messageQueue(config.messageQueueLimit),
+    arena_(),
     players(),
+    randomEngine(),
+    reseeded_(false),
     currentDirection_(),
     currentColor_(),
     deck(),
     discardPile(),
     activePlayerIndex_(-1),
     currentSetScore_(0),
+    pendingDraw_(0),
+    config_(config),
     playerInfo(),
-    randomEngine(),
+    handSizes_(),
+    scores_(),
+    setPlayers(),
+    seats_(),
+    drawnCards(),
     broadcaster(nullptr),
-    setsLimit(DEFAULT_SETS_LIMIT),
-    turnsLimit(DEFAULT_TURNS_LIMIT)
-{
-    players.reserve(MAX_NUMBER_OF_PLAYERS);
-    playerInfo.reserve(MAX_NUMBER_OF_PLAYERS);
-    deck.reserve(DECK_SIZE);
-    discardPile.reserve(DECK_SIZE);
+    decisionObservers(),
+    decisionTiming(false),
+    decisionBudget()
+{
+    if (!config.valid()) throw std::invalid_argument("Invalid game config");
+    players.reserve(config.maxPlayers);
+    playerInfo.reserve(config.maxPlayers);
+    handSizes_.reserve(config.maxPlayers);
+    scores_.reserve(config.maxPlayers);
+    deck.reserve(config.deckSize());
+    discardPile.reserve(config.deckSize());
+    setPlayers.reserve(config.maxPlayers);
+    seats_.reserve(config.maxPlayers);
+    drawnCards.reserve(config.deckSize());
+    messageQueue.setArena(&arena_);
     broadcaster.setQueue(&messageQueue);
+#ifdef UNO_PROFILE
+    broadcaster.setProfile(&gameProfile_);
+#endif
     prepareDeck();
 }
 
@@ -52,24 +81,12 @@ const Card *UnoGame::topCard() const
 
 std::vector<int> UnoGame::numberOfCards() const
 {
-    std::vector<int> result;
-    std::transform(
-        playerInfo.begin(), 
-        playerInfo.end(), 
-        std::back_inserter(result),
-        [](const PlayerInfo& info) { return info.hand.size(); });
-    return result;
+    return std::vector<int>(handSizes_.begin(), handSizes_.end());
 }
 
 std::vector<int> UnoGame::currentScores() const
 {
-    std::vector<int> result;
-    std::transform(
-        playerInfo.begin(), 
-        playerInfo.end(), 
-        std::back_inserter(result),
-        [](const PlayerInfo& info) { return info.currentScore; });
-    return result;
+    return std::vector<int>(scores_.begin(), scores_.end());
 }
 
 int UnoGame::cardsLeft() const
@@ -80,17 +97,21 @@ int UnoGame::cardsLeft() const
 void UnoGame::addPlayer(UnoPlayer *player)
 {
     if (player == nullptr) return;
-    if (numberOfPlayers() >= MAX_NUMBER_OF_PLAYERS)
+    if (numberOfPlayers() >= config_.maxPlayers)
         throw std::overflow_error("Maximum number of players reached");
     
     // Сообщаем игроку необходимую информацию об игре
-    player->addToGame(players.size(), this, &messageQueue);
+    player->addToGame(players.size(), this, &messageQueue, &arena_);
     
     // Сохраняем игрока
     players.push_back(player);
 
     // Сохраняем информацию об игроке
     playerInfo.push_back(PlayerInfo());
+    playerInfo.back().hand.reserve(deckSize());
+    handSizes_.push_back(0);
+    scores_.push_back(0);
+    seats_.push_back(-1);
 
     // Подписываем игрока на игровые события
     broadcaster.addListener(player);
@@ -102,6 +123,12 @@ void UnoGame::addObserver(Observer *observer)
     broadcaster.addListener(observer);
 }
 
+void UnoGame::addDecisionObserver(DecisionObserver *observer)
+{
+    if (observer == nullptr) return;
+    decisionObservers.push_back(observer);
+}
+
 void UnoGame::shufflePlayers()
 {
     std::vector<int> permutation(numberOfPlayers());
@@ -123,16 +150,30 @@ void UnoGame::shufflePlayers(const std::vector<int> &permutation)
 void UnoGame::setMessageQueueSizeLimit(int m)
 {
     messageQueue.setLimit(m);
+    config_.messageQueueLimit = m;
 }
 
 void UnoGame::setRandomGeneratorSeed(unsigned seed)
 {
     randomEngine.seed(seed);
+    reseeded_ = true;
+}
+
+void UnoGame::setDecisionBudget(const DecisionBudget &budget)
+{
+    decisionBudget = budget;
+    if (budget.limited()) decisionTiming = true;
+}
+
+void UnoGame::resetDecisionLatency()
+{
+    for (PlayerInfo& info: playerInfo) info.latency.clear();
 }
 
 void UnoGame::initPlayerInfo()
 {
-    for (PlayerInfo& info: playerInfo) info.currentScore = 0;
+    for (PlayerInfo& info: playerInfo) info.gameDecisionTime = 0;
+    std::fill(scores_.begin(), scores_.end(), 0);
     for (UnoPlayer * player : players) 
         broadcaster.handlePlayerEntered(player->playerIndex(), player->name());
     currentSetNumber_ = 0;
@@ -146,26 +187,35 @@ std::tuple<int, int> UnoGame::runSet()
 
 std::tuple<int, int> UnoGame::runGame()
 {
+#ifdef UNO_PROFILE
+    gameProfile_.clear();
+#endif
     initPlayerInfo();
     
     int winner = -1, score = 0; 
     
     do
     {
-        if (setsLimit > 0 && currentSetNumber_ >= setsLimit)
+        if (config_.setsLimit > 0 && currentSetNumber_ >= config_.setsLimit)
         {
             std::tie(winner, score) = findWinner();
             broadcaster.handleSetsLimitReached(winner, score);
+#ifdef UNO_PROFILE
+            runProfile_.add(gameProfile_);
+#endif
             return std::make_tuple(winner, score);
         }
         std::tie(winner, score) = runSet_();
         if (winner < 0) continue;
     } 
-    while(playerInfo.at(winner).currentScore < WINNING_SCORE);
+    while(scores_.at(winner) < config_.winningScore);
     
-    score = playerInfo.at(winner).currentScore;
+    score = scores_.at(winner);
     
     broadcaster.handlePlayerWonGame(winner, score);
+#ifdef UNO_PROFILE
+    runProfile_.add(gameProfile_);
+#endif
 
     return std::make_tuple(winner, score);
 }
@@ -187,9 +237,17 @@ void UnoGame::shufflePlayers_(const std::vector<int> &permutation)
     {
         std::iter_swap(players.begin() + i, players.begin() + j);
         if (!playerInfo.empty())
+        {
             std::iter_swap(playerInfo.begin() + i, playerInfo.begin() + j);
+            std::iter_swap(handSizes_.begin() + i, handSizes_.begin() + j);
+            std::iter_swap(scores_.begin() + i, scores_.begin() + j);
+        }
         ++i;
     }
+    // Игроки должны знать свои новые номера, иначе их номера разойдутся с
+    // номерами в playerInfo
+    for (int k = 0; k < numberOfPlayers(); ++k)
+        players[k]->addToGame(k, this, &messageQueue, &arena_);
 }
 
 void UnoGame::prepareDeck()
@@ -198,33 +256,44 @@ void UnoGame::prepareDeck()
         {CardColor::Blue, CardColor::Green, CardColor::Red, CardColor::Yellow};
     std::vector<int> doubles = {CardValue::Draw2, CardValue::Skip, CardValue::Reverse};
     for (int val = 1; val <= 9; ++val) doubles.push_back(val);
-    for (CardColor c : colors)
+    // Номер карты — ее порядковый номер при создании колоды, сквозной для
+    // всех колод
+    int id = 0;
+    for (int d = 0; d < config_.decks; ++d)
     {
-        for (int val : doubles) 
+        for (CardColor c : colors)
+        {
+            for (int val : doubles) 
+            {
+                deck.push_back(new Card(c, val, id++));
+                deck.push_back(new Card(c, val, id++));
+            }
+            deck.push_back(new Card(c, 0, id++));
+        }
+        for (int i = 0; i < 4; ++i)
         {
-            deck.push_back(new Card(c, val));
-            deck.push_back(new Card(c, val));
+            // Цвет может быть любой
+            deck.push_back(new Card(CardColor::Blue, CardValue::Wild, id++));
+            deck.push_back(new Card(CardColor::Blue, CardValue::WildDraw4, id++));
         }
-        deck.push_back(new Card(c, 0));
-    }
-    for (int i = 0; i < 4; ++i)
-    {
-        // Цвет может быть любой
-        deck.push_back(new Card(CardColor::Blue, CardValue::Wild));
-        deck.push_back(new Card(CardColor::Blue, CardValue::WildDraw4));
     }
 }
 
 void UnoGame::moveToDeck()
 {
     clearHands();
-    deck.insert(deck.cend(), discardPile.begin(), discardPile.end());
+    deck.append(discardPile.begin(), discardPile.end());
     discardPile.clear();
 }
 
 void UnoGame::shuffleDeck()
 {
-    std::shuffle(deck.begin(), deck.end(), randomEngine);
+    if (reseeded_)
+    {
+        deck.sortById();
+        reseeded_ = false;
+    }
+    deck.shuffle(randomEngine);
 }
 
 void UnoGame::clearDeck()
@@ -237,15 +306,20 @@ void UnoGame::clearHands()
 {
     for (auto & info : playerInfo)
     {
-        deck.insert(deck.cend(), info.hand.begin(), info.hand.end());
+        deck.append(info.hand.begin(), info.hand.end());
         info.hand.clear();
     }
+    std::fill(handSizes_.begin(), handSizes_.end(), 0);
 }
 
-std::vector<const Card *> UnoGame::getCardsFromDeck(const UnoPlayer *player, int numberOfCards)
+const std::vector<const Card *>& UnoGame::getCardsFromDeck(
+    const UnoPlayer *player, int numberOfCards)
 {
     if (player == nullptr || numberOfCards == 0) 
-        return std::vector<const Card*>();
+    {
+        drawnCards.clear();
+        return drawnCards;
+    }
     if (numberOfCards > deck.size() + discardPile.size() - 1)
     {
         // Выдать такое количество карт физически невозможно, поэтому выдаем,
@@ -259,37 +333,42 @@ std::vector<const Card *> UnoGame::getCardsFromDeck(const UnoPlayer *player, int
         flushDiscardPile();
         broadcaster.handleDeckShuffled();
     }
-    auto forPlayer = chooseCards(player, numberOfCards);
+    // Замеряется только работа с колодой: рассылка выше и получение карт
+    // игроком не входят в этап
+    UNO_PROFILE_PHASE(gameProfile_, SetPhase::Deal);
+    // Пустой вектор по умолчанию не выделяет память
+    auto chosen = chooseCards(player, numberOfCards);
     // По умолчанию выдаем с конца колоды
-    if (forPlayer.empty()) 
+    if (chosen.empty()) 
     {
-        forPlayer.insert(forPlayer.cend(), 
-            deck.rbegin(), deck.rbegin() + numberOfCards);   
-        deck.resize(deck.size() - numberOfCards);
+        drawnCards.assign(deck.cards().rbegin(), deck.cards().rbegin() + numberOfCards);
+        deck.popBack(numberOfCards);
     }
     // Переопределенное поведение
     else 
     {
-        if (forPlayer.size() != numberOfCards) 
+        if (chosen.size() != numberOfCards) 
             throw std::length_error("Invalid number of cards");
-        std::vector<const Card*> newDeck;
-        newDeck.reserve(DECK_SIZE);
-        std::copy_if(deck.begin(), deck.end(), std::back_inserter(newDeck),
-            [&forPlayer](const Card* card) {
-            return std::find(forPlayer.begin(), forPlayer.end(), card) == forPlayer.end();
-        });
-        if (newDeck.size() != deck.size() - numberOfCards)
+        // Карты убираются из колоды по индексу, каждая за O(1). Если карты
+        // в колоде нет (в том числе если она повторяется), уже убранные
+        // карты возвращаются в колоду
+        for (size_t i = 0; i < chosen.size(); ++i)
+        {
+            if (deck.remove(chosen[i])) continue;
+            deck.append(chosen.begin(), chosen.begin() + i);
             throw std::domain_error("Invalid values in choosen hand");
-        deck = std::move(newDeck);
+        }
+        drawnCards.assign(chosen.begin(), chosen.end());
     }
     auto & playerHand = playerInfo.at(player->playerIndex()).hand;
-    playerHand.insert(playerHand.cend(), forPlayer.begin(), forPlayer.end());
-    return forPlayer;
+    playerHand.insert(playerHand.cend(), drawnCards.begin(), drawnCards.end());
+    handChanged(player->playerIndex());
+    return drawnCards;
 }
 
 bool UnoGame::dealCards(UnoPlayer *player, int numberOfCards)
 {
-    auto forPlayer = getCardsFromDeck(player, numberOfCards);
+    const auto & forPlayer = getCardsFromDeck(player, numberOfCards);
     if (forPlayer.empty()) return false;
     player->receiveCards(forPlayer);
     return forPlayer.size() == numberOfCards;
@@ -303,16 +382,14 @@ void UnoGame::placeFirstCard()
         if (firstCard == nullptr) 
         {
             discardPile.push_back(deck.back());
-            deck.pop_back();
+            deck.popBack();
         }
         // переопределенное поведение
         else 
         {
-            auto cardEntry = std::find(deck.begin(), deck.end(), firstCard);
-            if (cardEntry == deck.end()) 
+            if (!deck.remove(firstCard)) 
                 throw std::domain_error("Invalid first card value");
-            discardPile.push_back(*cardEntry);
-            deck.erase(cardEntry);
+            discardPile.push_back(firstCard);
         }
     // Карта не может быть "Возьми 4", так что пытаемся еще раз, если попалась она.
     } while(topCard()->value == CardValue::WildDraw4);
@@ -324,268 +401,71 @@ void UnoGame::placeFirstCard()
 
 std::tuple<int, int> UnoGame::runSet_()
 {
-    // Проверим, что игроков хотя бы 2
-    if (numberOfPlayers() < MIN_NUMBER_OF_PLAYERS)
-        throw std::underflow_error("Too few players!");
-
-    // Инициализация
-    activePlayerIndex_ = 0;
-    currentSetScore_ = 0;
-    currentDirection_ = GameDirection::Direct;
-    currentTurnNumber_ = 0;
-    
-    ++currentSetNumber_;
-
-    // Подготовка колоды
-    moveToDeck();
-
-    // Сообщаем о том, что началась партия
-    broadcaster.handleSetStarted(currentSetNumber_);
-    
-    shuffleDeck();
-    broadcaster.handleDeckShuffled();
-
-    // Подготовка игроков
-
-    // Список игроков этой партии
-    // из этого списка могут исключаться игроки при дисквалификации
-    std::list<UnoPlayer*> set_players(players.begin(), players.end());
-
-    // Каждому раздаем по 7 карт
-    for (UnoPlayer * player : set_players) 
-    {
-        dealCards(player, INITIAL_CARDS_NUMBER);
-        broadcaster.handlePlayerDealt(player->playerIndex(), INITIAL_CARDS_NUMBER);
-    }
-    
-    // В сброс помещается карта из колоды
-    placeFirstCard();
-    if (!topCard()->is_wild()) currentColor_ = topCard()->color;
-    broadcaster.handleFirstCardPlaced(topCard());
-
-    // Если лежит "Закажи цвет", то первый игрок заказывает цвет
-    if (topCard()->value == CardValue::Wild)
-    {
-        CardColor newColor = activePlayer()->changeColor();
-        currentColor_ = newColor;
-        broadcaster.handlePlayerChangedColor(activePlayerIndex_, newColor);
-    }
-    
-    // Если лежит "Обратный ход", то меняется направление игры
-    if (topCard()->value == CardValue::Reverse)
-    {
-        currentDirection_ = GameDirection::Inverse;
-        broadcaster.handleDirectionChanged(currentDirection_);
-    }
-
-    // Должно ли выполняться действие карты действий 
-    // Действие не выполняется для игрока, который ходит после
-    // дисквалифицированного игрока или после игрока, пропустившего ход
-    bool actionShouldApply = true;
-    
-    // Основной игровой цикл
-    while (true)
-    {
-        currentTurnNumber_++;
-        if (turnsLimit > 0 && currentTurnNumber_ >= turnsLimit)
-        {
-            broadcaster.handleTurnsLimitReached();
-            return std::make_tuple(-1, 0);
-        }
-        // Должен ли игрок пропустить ход
-        bool shouldSkip = false;
-        int additionalCards = 0;
-        // Применяем действие карты на игрока
-        if (actionShouldApply)
-        {
-            switch (topCard()->value)
-            {
-                case CardValue::Draw2:
-                    shouldSkip = true;
-                    additionalCards = 2;
-                    break;
-                case CardValue::Skip:
-                    shouldSkip = true;
-                    break;
-                case CardValue::WildDraw4:
-                    shouldSkip = true;
-                    additionalCards = 4;
-                    break;
-            }
-        }
-        // Игрок берет карты пропускает ход
-        if (shouldSkip)
-        {
-            if (additionalCards > 0) 
-                dealCards(activePlayer(), additionalCards);
-            broadcaster.handlePlayerDrewAndSkip(activePlayerIndex_, additionalCards);
-            // Переход к следующему игроку
-            activePlayerIndex_ = nextPlayerIndex(set_players);
-            // На следующего игрока верхняя карта не действует
-            actionShouldApply = false;
-            continue;
-        }
-        // Карты активного игрока
-        auto & hand = playerInfo.at(activePlayerIndex_).hand;
-
-        const Card * newCard = nullptr;
-
-        // Если игрок может положить карту, то у него запрашивается карта
-        if (canPlaceCard(activePlayer(), topCard()))
-            newCard = activePlayer()->playCard();
-        // Если игрок не может положить карту, он тянет еще одну из колоды
-        else 
-        {
-            // Если в колоде и сбросе есть хотя бы одна карта, кроме верхней 
-            // карты сброса
-            if (deck.size() + discardPile.size() > 1)
-            {
-                const Card * additionalCard = getCardsFromDeck(activePlayer(), 1).at(0);
-                // Спрашиваем игрока, хочет ли он такую карту положить
-                bool place = activePlayer()->drawAdditionalCard(additionalCard);
-                // Если да, то кладем ее
-                if (place) newCard = additionalCard;
-                // Если нет, то игрок пропускает ход
-                else shouldSkip = true;
-            }
-            // Если игроку неоткуда тянуть карту, то он просто пропускает ход
-            else shouldSkip = true;
-            broadcaster.handlePlayerDrewAnotherCard(activePlayerIndex_);
-        }
-        if (shouldSkip) 
-        {
-            activePlayerIndex_ = nextPlayerIndex(set_players);
-            actionShouldApply = false;
-            continue;
-        }
-
-        // Пытаемся найти карту, которую положил игрок у него на руках
-        
-        // Итератор, указывающий на карту в руке игрока или hand.end(), если 
-        // такой карты нет.
-        auto handEntry = std::find_if(
-            hand.begin(), hand.end(), 
-            [newCard](const Card * card) { 
-                return newCard != nullptr
-                    && card->color == newCard->color 
-                    && card->value == newCard->value;
-            }); 
-        bool shouldDisqualify = newCard == nullptr 
-            || !newCard->is_valid()
-            || handEntry == hand.end()  // такой карты у него на руках нет
-            || (haveMatchingColor(activePlayer(), currentColor_) 
-                && newCard->value == CardValue::WildDraw4)
-            || (!newCard->is_wild()
-                && newCard->value != topCard()->value 
-                && newCard->color != currentColor_);
-        
-        if (shouldDisqualify)
-        {
-            // Дисквалификация игрока
-
-            // Считаем его очки и добавляем в текущий выигрыш
-            int score = countHandScore(activePlayerIndex_);
-            int disqualifiedPlayer = activePlayerIndex_;
-            currentSetScore_ += score;
-            // Определяем следующего игрока
-            int tempActivePlayerIndex = nextPlayerIndex(set_players);
-            set_players.erase(activePlayerIterator(set_players));
-            broadcaster.handlePlayerDisqualified(
-                disqualifiedPlayer, score, newCard);
-            activePlayerIndex_ = tempActivePlayerIndex;
-            if (set_players.size() == 1) break;
-            actionShouldApply = false;
-            continue;
-        }
-
-        newCard = *handEntry;
-        // Положить newCard в discardPile.
-        discardPile.push_back(newCard);
-        
-        // Убрать из руки игрока newCard.
-        hand.erase(handEntry);
-
-        if (!newCard->is_wild()) currentColor_ = newCard->color;
-
-        broadcaster.handleCardPlayed(activePlayerIndex_, newCard);
-        
-        // Если у игрока не осталось карт — выйти из цикла
-        if (hand.empty()) break;
-
-        // Если newCard — дикая, то спросить новый цвет
-        if (newCard->is_wild()) 
-        {
-            CardColor newColor = activePlayer()->changeColor();
-            currentColor_ = newColor;
-            broadcaster.handlePlayerChangedColor(activePlayerIndex_, newColor);
-        }
-
-        // Если newCard — "Обратный ход", то сменить направление.
-        if (newCard->value == CardValue::Reverse)
-        {
-            currentDirection_ = currentDirection_ == GameDirection::Direct
-                ? GameDirection::Inverse
-                : GameDirection::Direct;
-            broadcaster.handleDirectionChanged(currentDirection_);
-        }
-
-        // Перейти к следующему игроку 
-        activePlayerIndex_ = nextPlayerIndex(set_players);
-        actionShouldApply = true;
-    }
-    // Для всех игроков в set_players посчитать очки
-    for (UnoPlayer * player : set_players)
-    {
-        if (activePlayerIndex_ == player->playerIndex()) continue;
-        currentSetScore_ += countHandScore(player->playerIndex());
-    }
-    playerInfo.at(activePlayerIndex_).currentScore += currentSetScore_;
-    // вернуть итоги
-    broadcaster.handlePlayerWonSet(activePlayerIndex_, currentSetScore_);
-    return std::make_tuple(activePlayerIndex_, currentSetScore_);
+    return runSetImpl();
 }
 
 void UnoGame::flushDiscardPile()
 {
     if (discardPile.size() < 2) return;
     // Переносим из стопки сброса в колоду все карты, кроме верхней
-    deck.insert(deck.cend(), discardPile.begin(), discardPile.end() - 1);
+    deck.append(discardPile.begin(), discardPile.end() - 1);
     // Перемещаем верхнюю карту в начало
     std::swap(discardPile.back(), discardPile.front());
     discardPile.resize(1);
     shuffleDeck();
 }
 
+void UnoGame::decisionRequested(DecisionType type, const Card *offered)
+{
+    if (decisionObservers.empty()) return;
+    const auto & hand = playerInfo.at(activePlayerIndex_).hand;
+    for (DecisionObserver * observer : decisionObservers)
+        observer->handleDecisionRequested(
+            *this, activePlayerIndex_, type, hand, offered);
+}
+
+void UnoGame::decisionMade(DecisionType type, const Card *card, CardColor color)
+{
+    for (DecisionObserver * observer : decisionObservers)
+        observer->handleDecisionMade(activePlayerIndex_, type, card, color);
+}
+
 UnoPlayer *UnoGame::activePlayer()
 {
     return players.at(activePlayerIndex_);
 }
 
-std::list<UnoPlayer *>::iterator UnoGame::activePlayerIterator(
-    std::list<UnoPlayer *>& playersList)
+void UnoGame::seatSetPlayers()
 {
-    int current = activePlayerIndex_;
-    return std::find_if(
-        playersList.begin(), 
-        playersList.end(),
-        [current](UnoPlayer * player) { return player->playerIndex() == current; });
+    std::fill(seats_.begin(), seats_.end(), -1);
+    for (size_t seat = 0; seat < setPlayers.size(); ++seat)
+        seats_[setPlayers[seat]->playerIndex()] = seat;
 }
 
-int UnoGame::nextPlayerIndex(std::list<UnoPlayer *>& playersList)
+void UnoGame::unseatActivePlayer()
 {
-    auto it = activePlayerIterator(playersList);
+    // Дисквалификации редки, поэтому места следующих игроков сдвигаются
+    // за O(n), зато переход хода остается O(1)
+    const int seat = activeSeat();
+    setPlayers.erase(setPlayers.begin() + seat);
+    seats_[activePlayerIndex_] = -1;
+    for (size_t k = seat; k < setPlayers.size(); ++k)
+        seats_[setPlayers[k]->playerIndex()] = k;
+}
+
+int UnoGame::nextPlayerIndex()
+{
+    const int n = setPlayers.size();
+    int seat = activeSeat();
     if (currentDirection_ == GameDirection::Direct)
-    {
-        ++it;
-        if (it == playersList.end()) it = playersList.begin();
-    }
-    else if (it == playersList.begin()) it = --playersList.end();
-    else --it;
-    return (*it)->playerIndex();
+        seat = seat + 1 == n ? 0 : seat + 1;
+    else seat = seat == 0 ? n - 1 : seat - 1;
+    return setPlayers[seat]->playerIndex();
 }
 
 bool UnoGame::canPlaceCard(UnoPlayer *player, const Card *topCard_)
 {
+    UNO_PROFILE_PHASE(gameProfile_, SetPhase::LegalityCheck);
     auto& hand = playerInfo.at(player->playerIndex()).hand;
     if (haveMatchingColor(player, currentColor_)) return true;
     return std::any_of(
@@ -605,6 +485,83 @@ bool UnoGame::haveMatchingColor(UnoPlayer *player, CardColor color)
         });
 }
 
+bool UnoGame::haveMatchingValue(UnoPlayer *player, int value)
+{
+    auto& hand = playerInfo.at(player->playerIndex()).hand;
+    return std::any_of(
+        hand.begin(), hand.end(), 
+        [value](const Card * card) { return card->value == value; });
+}
+
+int UnoGame::findJumpIn(const Card *card, const Card *& jumpCard)
+{
+    const int n = setPlayers.size();
+    const int active = activeSeat();
+    for (int k = 1; k < n; ++k)
+    {
+        const int position = currentDirection_ == GameDirection::Direct
+            ? (active + k) % n
+            : (active - k + n) % n;
+        UnoPlayer * player = setPlayers[position];
+        const auto & hand = playerInfo.at(player->playerIndex()).hand;
+        auto same = [card](const Card * c) 
+            { return c->color == card->color && c->value == card->value; };
+        if (std::none_of(hand.begin(), hand.end(), same)) continue;
+        const Card * chosen = player->jumpIn(card);
+        // Вмешательство необязательно, поэтому неверный ответ — отказ
+        if (chosen == nullptr || !same(chosen)) continue;
+        jumpCard = *std::find_if(hand.begin(), hand.end(), same);
+        return player->playerIndex();
+    }
+    return -1;
+}
+
+void UnoGame::swapHands(int firstPlayer, int secondPlayer)
+{
+    // Векторы обмениваются буферами, так что карты не копируются
+    playerInfo.at(firstPlayer).hand.swap(playerInfo.at(secondPlayer).hand);
+    handChanged(firstPlayer);
+    handChanged(secondPlayer);
+    broadcaster.handleHandsSwapped(firstPlayer, secondPlayer);
+}
+
+void UnoGame::swapWithChosenPlayer()
+{
+    int target = activePlayer()->chooseSwapPlayer();
+    auto isOpponent = [this](int index) {
+        return index != activePlayerIndex_ 
+            && index >= 0 && index < numberOfPlayers() 
+            && inSet(index);
+    };
+    if (!isOpponent(target))
+    {
+        target = -1;
+        for (UnoPlayer * player : setPlayers)
+        {
+            const int index = player->playerIndex();
+            if (index != activePlayerIndex_ 
+                && (target < 0 || handSizes_[index] < handSizes_[target]))
+                target = index;
+        }
+    }
+    swapHands(activePlayerIndex_, target);
+}
+
+void UnoGame::rotateHands()
+{
+    // Рука i-того по направлению игрока переходит к (i+1)-му: последовательный
+    // обмен первой руки со второй, третьей и т. д. Векторы обмениваются
+    // буферами, а наблюдатели получают одно событие на весь круг
+    const int n = setPlayers.size();
+    const int first = currentDirection_ == GameDirection::Direct ? 0 : n - 1;
+    const int step = currentDirection_ == GameDirection::Direct ? 1 : -1;
+    auto & firstHand = playerInfo.at(setPlayers[first]->playerIndex()).hand;
+    for (int k = 1; k < n; ++k)
+        firstHand.swap(playerInfo.at(setPlayers[first + k * step]->playerIndex()).hand);
+    for (UnoPlayer * player : setPlayers) handChanged(player->playerIndex());
+    broadcaster.handleHandsRotated(currentDirection_);
+}
+
 int UnoGame::countHandScore(int playerIndex)
 {
     int sum = 0;
@@ -615,7 +572,7 @@ int UnoGame::countHandScore(int playerIndex)
 
 std::tuple<int, int> UnoGame::findWinner()
 {
-    auto scores = currentScores();
+    const auto & scores = scores_;
     auto maxScoreIterator = std::max_element(scores.begin(), scores.end());
     int maxScore = *maxScoreIterator;
     int maxScorePlayers = std::count(scores.begin(), scores.end(), maxScore);
@@ -625,33 +582,52 @@ std::tuple<int, int> UnoGame::findWinner()
 
 bool UnoGame::deckIsConsistent()
 {
-    std::set<const Card*> deckSet(deck.begin(), deck.end());
-    return deckSet.size() == deck.size();
+    return deck.isConsistent();
 }
 
 void UnoGame::EventBroadcaster::flushMessages()
 {
     if (queue == nullptr) return;
-    int player;
-    std::string message;
-    for (auto it = queue->cbegin(); it != queue->cend(); ++it)
+    // Обработчики могут добавлять сообщения, поэтому очередь проходится по
+    // номерам, а сообщение копируется в буфер, сохраняющий выделенную память
+    for (size_t i = 0; i < queue->size(); ++i)
     {
-        std::tie(player, message) = *it;
-        handlePlayerSaid(player, message);
+        const int player = std::get<0>(queue->at(i));
+        const ArenaString& text = std::get<1>(queue->at(i));
+        said.assign(text.data(), text.size());
+        handlePlayerSaid(player, said);
     }
     if (queue->hasOverflow()) handleMessageOverflow();
     queue->clear();
 }
 
+#ifdef UNO_PROFILE
+void UnoGame::EventBroadcaster::beforeEach(GameEvent event)
+{
+    // Сообщения рассылаются внутри flushMessages и замеряются вместе с ним
+    if (event == GameEvent::PlayerSaid || event == GameEvent::MessageOverflow)
+        return;
+    eventStart = readCycleCounter();
+}
+#endif
+
 void UnoGame::EventBroadcaster::afterEach(GameEvent event)
 {
     if (event == GameEvent::PlayerSaid || event == GameEvent::MessageOverflow)
         return;
+#ifdef UNO_PROFILE
+    const std::uint64_t flushStart = readCycleCounter();
+    if (profile != nullptr) profile->record(SetPhase::Broadcast, flushStart - eventStart);
+    flushMessages();
+    if (profile != nullptr)
+        profile->record(SetPhase::FlushMessages, readCycleCounter() - flushStart);
+#else
     flushMessages();
+#endif
 }
 
 UnoGame::EventBroadcaster::EventBroadcaster(MessageQueue *messageQueue):
-    queue(messageQueue), listeners()
+    listeners(), queue(messageQueue), said()
 {
 }
 
@@ -8,10 +8,18 @@
 #include <algorithm>
 #include <random>
 #include <set>
+#include <memory>
+#include <functional>
 
 #include "card.h"
+#include "deck.h"
+#include "game_config.h"
+#include "rules.h"
 #include "events.h"
 #include "game_components.h"
+#include "span.h"
+#include "profiler.h"
+#include "decision_timer.h"
 
 class UnoGame;
 
@@ -37,20 +45,27 @@ class UnoPlayer: public Observer
     const UnoGame * currentGame;
     /// @brief Очередь сообщений, куда игрок отправляет сообщения.
     MessageQueue * messageQueue;
+    /// @brief Арена партии текущей игры.
+    SetArena * setArena_;
     
 
     /// @brief Метод, который вызывается классом Игры при начале игры. 
     /// @param playerIndex номер игрока.
     /// @param currentGame указатель на текущую игру.
     /// @param queue очередь сообщений текущей игры.
+    /// @param arena арена партии текущей игры.
     void addToGame(
         int playerIndex, 
         const UnoGame* currentGame, 
-        MessageQueue * queue);
+        MessageQueue * queue,
+        SetArena * arena);
     
     // Для того, чтобы метод выше можно было вызвать только из класса игры
     friend class UnoGame;
 protected:
+    UnoPlayer(): 
+        playerIndex_(-1), currentGame(nullptr), messageQueue(nullptr), setArena_(nullptr) {}
+
     /// @brief Отправляет сообщение от игрока другим игрокам.
     /// @param message сообщение.
     /// @return true, если отправка произошла успешно, иначе false.
@@ -61,6 +76,20 @@ protected:
     /// @return текущая игра.
     const UnoGame* game() const { return currentGame; }
 
+    /// @brief Арена партии для временных данных игрока, например списков
+    /// возможных ходов: `ArenaVector<const Card*> moves(arena());`.
+    /// @details Память арены действительна до начала следующей партии, так
+    /// что хранить на ней можно только данные текущей партии. Вне игры
+    /// возвращает nullptr, и контейнеры берут память из кучи.
+    SetArena * arena() const { return setArena_; }
+
+    /// @return карты на руке игрока, как их хранит игра.
+    /// @details Диапазон действителен до следующего изменения руки (хода или
+    /// выдачи карт), поэтому его нужно запрашивать заново для каждого
+    /// решения. Во время решения `drawAdditionalCard` вытянутая карта уже
+    /// лежит на руке. Вне игры возвращает пустой диапазон.
+    CardSpan myHand() const;
+
 public:
     /// @return номер этого игрока за столом.
     int playerIndex() const { return playerIndex_; }
@@ -70,8 +99,9 @@ public:
     virtual std::string name() const = 0;
     
     /// @brief Игрок получает на руки карты.
-    /// @param cards массив карт.
-    virtual void receiveCards(const std::vector<const Card*>& cards) = 0;
+    /// @param cards выданные карты; к моменту вызова они уже лежат на руке
+    /// ( @see myHand ), а сам диапазон действителен только во время вызова.
+    virtual void receiveCards(CardSpan cards) = 0;
 
     /// @brief Игрок возвращает карту, которую он сыграет (положит в сброс).
     /// @return карта, которую игрок положит в сброс.
@@ -87,6 +117,72 @@ public:
     /// игра запросит у него новый цвет.
     /// @return новый цвет.
     virtual CardColor changeColor() = 0;
+
+    /// @brief Задает сид собственного генератора случайных чисел игрока, чтобы
+    /// игры можно было воспроизвести (например, при настройке стратегии на
+    /// общих случайных числах). Игроки без случайности его не переопределяют.
+    virtual void seed(unsigned value) {}
+
+    // Решения домашних правил ( @see HouseRules ). Игроки, которые их не
+    // переопределяют, в них не участвуют.
+
+    /// @brief Правило "вмешательство": у игрока есть такая же карта, как
+    /// только что положенная `card`, и он может положить ее вне очереди.
+    /// @return карта с руки, совпадающая с `card` по цвету и значению, или
+    /// nullptr, если игрок не вмешивается.
+    virtual const Card * jumpIn(const Card * card) { return nullptr; }
+
+    /// @brief Правило 7-0: игрок положил 7 и выбирает, с кем поменяться
+    /// картами.
+    /// @return номер соперника в партии; если номер недопустим, то игра
+    /// выбирает соперника с наименьшим числом карт.
+    virtual int chooseSwapPlayer() { return -1; }
+};
+
+
+/// @brief Фабрика игроков; нужна, когда каждому потоку или каждой игре нужны
+/// свои экземпляры игроков.
+using PlayerFactory = std::function<std::unique_ptr<UnoPlayer>()>;
+
+
+/**
+ * @brief Наблюдатель за решениями игроков.
+ * 
+ * @details В отличие от Observer, получает руку принимающего решение игрока,
+ * поэтому подключается только к самой игре (см. UnoGame::addDecisionObserver),
+ * а игрокам не рассылается. Используется для записи обучающих данных.
+*/
+class DecisionObserver
+{
+public:
+    /// @brief Рука игрока, как ее хранит игра.
+    using Hand = std::vector<const Card *>;
+
+    /// @brief Игра запрашивает у игрока решение.
+    /// @param game игра; ее состояние — то, которое видит игрок.
+    /// @param playerIndex номер игрока в списке.
+    /// @param type тип решения.
+    /// @param hand карты на руке игрока.
+    /// @param offered вытянутая карта для решения `DrawAdditionalCard`, иначе
+    /// nullptr.
+    virtual void handleDecisionRequested(
+        const UnoGame& game,
+        int playerIndex,
+        DecisionType type,
+        const Hand& hand,
+        const Card * offered) {}
+
+    /// @brief Игрок принял решение.
+    /// @param playerIndex номер игрока в списке.
+    /// @param type тип решения.
+    /// @param card сыгранная карта; для `DrawAdditionalCard` — вытянутая карта,
+    /// если игрок ее сыграл, иначе nullptr.
+    /// @param color заказанный цвет для `ChangeColor`.
+    virtual void handleDecisionMade(
+        int playerIndex,
+        DecisionType type,
+        const Card * card,
+        CardColor color) {}
 };
 
 
@@ -102,35 +198,45 @@ public:
 class UnoGame 
 {
 public:
-    // Константы для игры
+    // Константы для игры: параметры по умолчанию ( @see GameConfig ).
+    // Параметры конкретной игры возвращает config().
 
     /// @brief Количество очков, необходимое для победы.
-    const int WINNING_SCORE = 500;
+    static constexpr int WINNING_SCORE = GameConfig().winningScore;
     /// @brief Минимальное количество игроков.
-    const int MIN_NUMBER_OF_PLAYERS = 2;
+    static constexpr int MIN_NUMBER_OF_PLAYERS = GameConfig().minPlayers;
     /// @brief Максимальное количество игроков.
-    const int MAX_NUMBER_OF_PLAYERS = 10;
+    static constexpr int MAX_NUMBER_OF_PLAYERS = GameConfig().maxPlayers;
 
-    /// @brief Размер колоды.
-    const int DECK_SIZE = 108;
+    /// @brief Размер одной колоды; размер колоды игры возвращает deckSize().
+    static constexpr int DECK_SIZE = STANDARD_DECK_SIZE;
 
     /// @brief Максимальное количество сообщений в очереди по умолчанию
-    const int DEFAULT_MESSAGE_QUEUE_LIMIT = 50;
+    static constexpr int DEFAULT_MESSAGE_QUEUE_LIMIT = GameConfig().messageQueueLimit;
 
     /// @brief Сколько карт изначально раздается игрокам.
-    const int INITIAL_CARDS_NUMBER = 7;
+    static constexpr int INITIAL_CARDS_NUMBER = GameConfig().initialCards;
 
     /// @brief Ограничение на количество ходов по умолчанию
-    const unsigned DEFAULT_TURNS_LIMIT = 100000U;
+    static constexpr unsigned DEFAULT_TURNS_LIMIT = GameConfig().turnsLimit;
 
     /// @brief Ограничение на количество партий в одной игре по умолчанию
-    const unsigned DEFAULT_SETS_LIMIT = 1000;
+    static constexpr unsigned DEFAULT_SETS_LIMIT = GameConfig().setsLimit;
+
+    // Микробенчмаркам (bench/) нужен доступ к служебным методам
+    friend class UnoGameBenchmark;
+    // Игрок видит свою руку ( @see UnoPlayer::myHand )
+    friend class UnoPlayer;
 
 private:
 
     /// @brief Очередь сообщений
     MessageQueue messageQueue;
 
+    /// @brief Арена для временных данных партии; очищается перед событием
+    /// SetStarted ( @see UnoPlayer::arena ).
+    SetArena arena_;
+
     /// @brief Список игроков
     std::vector<UnoPlayer *> players;
 
@@ -138,6 +244,8 @@ private:
     /// @details Используется для перемешивания колоды и рассадки игроков в 
     /// случайном порядке.
     std::minstd_rand randomEngine;
+    /// @brief Сид сменили, и колода еще не перемешивалась с новым сидом.
+    bool reseeded_;
 
     // Игровое состояние
     
@@ -145,8 +253,9 @@ private:
     GameDirection currentDirection_;
     /// @brief Текущий цвет.
     CardColor currentColor_;
-    /// @brief Оставшаяся колода карт.
-    std::vector<const Card *> deck;
+    /// @brief Оставшаяся колода карт; индекс колоды позволяет убирать из нее
+    /// карты, выбранные `chooseCards` и `chooseFirstCard`, за O(1).
+    Deck deck;
     /// @brief Стопка сброса.
     std::vector<const Card *> discardPile;
     /// @brief Номер активного игрока.
@@ -154,6 +263,8 @@ private:
     /// @brief Текущий выигрыш в партии. Не 0 только если какой-то игрок был
     /// дисквалифицирован.
     int currentSetScore_;
+    /// @brief Штраф, накопленный по правилу stacking ( @see HouseRules ).
+    int pendingDraw_;
 
     /// @brief Номер текущей партии.
     int currentSetNumber_;
@@ -161,28 +272,51 @@ private:
     /// @brief Номер текущего хода
     unsigned currentTurnNumber_;
 
-    /// @brief Ограничение на число ходов
-    unsigned turnsLimit;
-
-    /// @brief Ограничение на число партий
-    unsigned setsLimit;
+    /// @brief Параметры игры, в том числе ограничения на число ходов и партий.
+    GameConfig config_;
 
     struct PlayerInfo
     {
-        /// @brief Карты на руках у игрока.
-        std::list<const Card *> hand;
-        /// @brief Количество его очков.
-        int currentScore;
-
-        PlayerInfo(): hand(), currentScore(0) {}
+        /// @brief Карты на руках у игрока; место под всю колоду выделяется
+        /// заранее, так что раздача не обращается к куче.
+        std::vector<const Card *> hand;
+        /// @brief Время решений игрока.
+        DecisionLatency latency;
+        /// @brief Суммарное время решений игрока за текущую игру, нс.
+        std::uint64_t gameDecisionTime;
+
+        PlayerInfo(): hand(), latency(), gameDecisionTime(0) {}
     };
 
     /// @brief Информация об игроках.
     std::vector<PlayerInfo> playerInfo;
 
+    // Открытое состояние игроков хранится отдельными массивами по номерам
+    // игроков, чтобы отдавать его диапазоном без копирования.
+
+    /// @brief Количество карт на руках; обновляется при каждом изменении руки
+    /// ( @see handChanged ).
+    std::vector<int> handSizes_;
+    /// @brief Количество очков игроков.
+    std::vector<int> scores_;
+
+    // Буферы партии. Место под них выделяется в конструкторе по
+    // наибольшему числу игроков и размеру колоды из config_, так что партия
+    // после первой не обращается к куче.
+
+    /// @brief Игроки текущей партии; дисквалифицированные удаляются.
+    std::vector<UnoPlayer *> setPlayers;
+    /// @brief seats_[i] — место игрока `i` в setPlayers или -1, если он не
+    /// играет в партии; по нему следующий игрок находится за O(1).
+    std::vector<int> seats_;
+    /// @brief Карты, выданные последним вызовом getCardsFromDeck.
+    std::vector<const Card *> drawnCards;
+
 public:
-    UnoGame();
-    ~UnoGame();
+    /// @throws std::invalid_argument если параметры недопустимы 
+    /// ( @see GameConfig::valid ).
+    explicit UnoGame(const GameConfig& config = GameConfig());
+    virtual ~UnoGame();
 
     // Интерфейс для получения текущего состояния партии.
 
@@ -192,35 +326,68 @@ public:
     CardColor currentColor() const { return currentColor_; }
     /// @return верхняя карта стопки сброса или nullptr, если стопка сброса пуста.
     const Card* topCard() const;
-    /// @return количество карт у игроков.
+    /// @return количество карт у игроков (копия handSizes()).
     std::vector<int> numberOfCards() const;
+    /// @return количество карт у игроков по их номерам. Диапазон
+    /// обновляется вместе с игрой и действителен, пока не добавлен игрок.
+    Span<const int> handSizes() const { return handSizes_; }
     /// @return возвращает текущий выигрыш в партии; не 0, только если какой-то
     /// игрок был дисквалифицирован.
     int currentSetScore() const { return currentSetScore_; }
+    /// @return сколько карт возьмет активный игрок, если не добавит к штрафу
+    /// "Возьми 2" или "Возьми 4" такую же карту; не 0 только по правилу
+    /// stacking ( @see HouseRules ).
+    int pendingDraw() const { return pendingDraw_; }
     /// @return возвращает номер в списке активного игрока.
     int activePlayerIndex() const { return activePlayerIndex_; }
-    /// @return количество очков на момент начала партии у всех игроков.
+    /// @return количество очков на момент начала партии у всех игроков
+    /// (копия scores()).
     std::vector<int> currentScores() const;
+    /// @return количество очков на момент начала партии у игроков по их
+    /// номерам. Диапазон действителен, пока не добавлен игрок.
+    Span<const int> scores() const { return scores_; }
     /// @return количество карт в колоде.
     int cardsLeft() const;
+    /// @return количество карт в игре (во всех колодах).
+    int deckSize() const { return config_.deckSize(); }
+    /// @return количество карт у игрока `playerIndex`.
+    int cardsOf(int playerIndex) const { return handSizes_[playerIndex]; }
+    /// @return количество очков игрока `playerIndex` на момент начала партии.
+    int scoreOf(int playerIndex) const { return scores_[playerIndex]; }
     /// @return количество игроков.
     int numberOfPlayers() const { return players.size(); }
+    /// @return играет ли игрок `playerIndex` в текущей партии (false, если
+    /// он дисквалифицирован).
+    bool inSet(int playerIndex) const { return seats_[playerIndex] >= 0; }
+    /// @return арена текущей партии.
+    const SetArena& setArena() const { return arena_; }
+    /// @return параметры игры.
+    const GameConfig& config() const { return config_; }
     /// @return номер текущей партии.
     int currentSetNumber() const { return currentSetNumber_; }
     /// @return номер текущего хода.
     int currentTurnNumber() const { return currentTurnNumber_; }
 
+    /// @return игрок с номером `playerIndex`. Доступен только через
+    /// неконстантную игру, так что игроки не могут обращаться друг к другу.
+    UnoPlayer* player(int playerIndex) { return players.at(playerIndex); }
+
 
     // Интерфейс для подготовки игры
 
     /// @brief Добавление игрока в игру.
     /// @param player игрок.
-    /// @throws std::overflow_error, если игроков уже 10.
+    /// @throws std::overflow_error, если игроков уже config().maxPlayers
+    /// (для больших столов @see GameConfig::forTable ).
     void addPlayer(UnoPlayer* player);
 
     /// @brief Добавление наблюдателя в игру.
     /// @param observer наблюдатель.
     void addObserver(Observer* observer);
+
+    /// @brief Добавление наблюдателя за решениями игроков.
+    /// @param observer наблюдатель.
+    void addDecisionObserver(DecisionObserver* observer);
     
     /// @brief Расположить игроков в случайном порядке.
     void shufflePlayers();
@@ -241,17 +408,31 @@ public:
     /// @brief Установить ограничение на число ходов в партии.
     /// @param limit максимальное число ходов, если передан 0, то ограничение не 
     /// ставится.
-    void setTurnsLimit(unsigned limit) { turnsLimit = limit; }
+    void setTurnsLimit(unsigned limit) { config_.turnsLimit = limit; }
 
     /// @brief Установить ограничение на число партий в игре.
     /// @param limit максимальное число партий, если передан 0, то ограничение 
     /// не ставится.
-    void setSetsLimit(unsigned limit) { setsLimit = limit; }
+    void setSetsLimit(unsigned limit) { config_.setsLimit = limit; }
 
     /// @brief Устанавливает новый сид для генератора.
+    /// @details Следующее перемешивание начинается с исходного порядка карт,
+    /// так что раздачи зависят только от сида, а не от прошлых игр.
     /// @param seed значение сида.
     void setRandomGeneratorSeed(unsigned seed);
 
+    /// @brief Включить или выключить замер времени решений игроков.
+    /// @details Замер стоит четырех чтений часов на решение, поэтому по
+    /// умолчанию выключен.
+    void setDecisionTiming(bool enabled) { decisionTiming = enabled; }
+
+    /// @brief Установить ограничения времени решений игроков. Игрок,
+    /// превысивший ограничение, дисквалифицируется из партии так же, как
+    /// игрок, сделавший недопустимый ход.
+    /// @details Если есть хотя бы одно ограничение, то включает замер времени
+    /// решений ( @see setDecisionTiming ).
+    void setDecisionBudget(const DecisionBudget& budget);
+
 
     // Интерфейс для проведения игры
 
@@ -272,6 +453,22 @@ public:
     /// @throws std::underflow_error, если игроков меньше 2.
     std::tuple<int, int> runGame();
 
+    /// @return время этапов партий последней (или текущей) игры. Заполняется,
+    /// только если игра собрана с макросом UNO_PROFILE ( @see profiler.h ).
+    const PhaseProfile& gameProfile() const { return gameProfile_; }
+    /// @return время этапов партий всех игр с последнего `resetProfile()`.
+    const PhaseProfile& runProfile() const { return runProfile_; }
+    /// @brief Обнуляет замеры этапов.
+    void resetProfile() { gameProfile_.clear(); runProfile_.clear(); }
+
+    /// @return время решений игрока `playerIndex` с последнего 
+    /// `resetDecisionLatency()`; заполняется, если включен замер времени 
+    /// решений.
+    const DecisionLatency& decisionLatency(int playerIndex) const
+        { return playerInfo.at(playerIndex).latency; }
+    /// @brief Обнуляет время решений всех игроков.
+    void resetDecisionLatency();
+
 protected:
 
     // Эти методы можно использовать для тестирования
@@ -302,7 +499,18 @@ protected:
     
     /// @brief Доступ к колоде карт, для перегрузок метода chooseCards.
     /// @return текущая колода.
-    const std::vector<const Card*>& getDeck() const { return deck; }
+    const std::vector<const Card*>& getDeck() const { return deck.cards(); }
+
+    /// @brief Проводит одну партию без инициализации и очистки колоды.
+    /// @see runSet()
+    /// @details По умолчанию партия идет по стандартным правилам; наследник
+    /// может подставить партию по домашним правилам ( @see HouseRulesGame ).
+    virtual std::tuple<int, int> runSet_();
+
+    /// @brief Партия с параметрами из config() по правилам `Rules`
+    /// ( @see StandardRules, HouseRules ). Определена в uno_game_impl.h.
+    template<class Rules = StandardRules>
+    std::tuple<int, int> runSetImpl();
 
 private:
 
@@ -322,6 +530,14 @@ private:
     {
         std::list<Observer *> listeners;
         MessageQueue * queue;
+        /// @brief Копия рассылаемого сообщения.
+        std::string said;
+#ifdef UNO_PROFILE
+        /// @brief Профиль, в который записывается время рассылки событий.
+        PhaseProfile * profile = nullptr;
+        /// @brief Начало рассылки текущего события.
+        std::uint64_t eventStart = 0;
+#endif
 
         /**
          * @brief Обработка всех накопившихся сообщений.
@@ -339,6 +555,9 @@ private:
         */ 
         void flushMessages();
     protected:
+#ifdef UNO_PROFILE
+        void beforeEach(GameEvent event) override;
+#endif
         void afterEach(GameEvent event) override;
         std::list<Observer*>::iterator begin() override { return listeners.begin(); }
         std::list<Observer*>::iterator end() override { return listeners.end(); }
@@ -348,10 +567,39 @@ private:
 
         void addListener(Observer * listener);
         void setQueue(MessageQueue * queue) { this->queue = queue; }
+#ifdef UNO_PROFILE
+        void setProfile(PhaseProfile * profile) { this->profile = profile; }
+#endif
     };
 
     EventBroadcaster broadcaster;
 
+    /// @brief Замеры этапов партий текущей игры и всех игр.
+    PhaseProfile gameProfile_, runProfile_;
+
+    /// @brief Наблюдатели за решениями игроков.
+    std::vector<DecisionObserver *> decisionObservers;
+
+    /// @brief Замерять ли время решений игроков.
+    bool decisionTiming;
+    /// @brief Ограничения времени решений.
+    DecisionBudget decisionBudget;
+
+    /// @brief Вызывает `decide`, решение активного игрока, и учитывает его
+    /// время, если замер времени решений включен.
+    /// @return false, если игрок превысил ограничение времени.
+    template<typename Decision>
+    bool timeDecision(Decision decide);
+
+    /// @brief Рассылает наблюдателям за решениями запрос решения активного
+    /// игрока.
+    void decisionRequested(DecisionType type, const Card * offered = nullptr);
+    /// @brief Рассылает наблюдателям за решениями решение активного игрока.
+    void decisionMade(
+        DecisionType type, 
+        const Card * card, 
+        CardColor color = CardColor::Red);
+
     /// @brief Перестановка игроков без проверок.
     /// @see void shufflePlayers(const std::vector<int>&);
     void shufflePlayers_(const std::vector<int>& permutation);   
@@ -367,6 +615,9 @@ private:
     /// @brief Очищает информацию об картах игроков, переносит карты из рук в 
     /// колоду.
     void clearHands();
+    /// @brief Обновляет `handSizes_` после изменения руки игрока.
+    void handChanged(int playerIndex)
+        { handSizes_[playerIndex] = playerInfo[playerIndex].hand.size(); }
 
     /// @brief Выбирает карты из колоды с помощью метода `chooseCards`, 
     /// добавляет их в руку игроку в `playerInfo` и удаляет из колоды.
@@ -377,7 +628,9 @@ private:
     /// количество карт;
     /// @throws std::domain_error, если `chooseCards` возвращает значения, 
     /// которые либо повторяются, либо отсутствуют в колоде.
-    std::vector<const Card*> getCardsFromDeck(
+    /// @details Возвращает ссылку на буфер `drawnCards`, который
+    /// перезаписывается следующим вызовом.
+    const std::vector<const Card*>& getCardsFromDeck(
         const UnoPlayer* player, int numberOfCards);
 
     /// @brief Выдает игроку карты из колоды. Может вызвать событие 
@@ -390,27 +643,44 @@ private:
     /// @brief Выбор первой карты, которая помещается в стопку сброса.
     void placeFirstCard();
 
-    /// @brief Проводит одну партию без инициализации и очистки колоды.
-    /// @see runSet()
-    std::tuple<int, int> runSet_();
-
     /// @brief Переместить все карты кроме верхней в колоду и перемешать.
     void flushDiscardPile();
 
     UnoPlayer * activePlayer();
-    std::list<UnoPlayer *>::iterator activePlayerIterator(
-        std::list<UnoPlayer *>& playersList);
+    /// @return место активного игрока в setPlayers.
+    int activeSeat() const { return seats_[activePlayerIndex_]; }
+
+    /// @brief Рассаживает игроков партии: заполняет seats_ по setPlayers.
+    void seatSetPlayers();
+    /// @brief Убирает активного игрока из игроков партии.
+    void unseatActivePlayer();
     
-    /// @brief Реализует логику перехода к следующему игроку.
-    /// @param playersList список игроков в партии.
+    /// @brief Реализует логику перехода к следующему игроку партии за O(1).
     /// @return номер следующего игрока.
-    int nextPlayerIndex(std::list<UnoPlayer *>& playersList);
+    int nextPlayerIndex();
 
     /// @return true, если у игрока есть карта чтобы положить ее на `topCard_`
     bool canPlaceCard(UnoPlayer * player, const Card* topCard_);
 
     /// @return true, если у игрока на руках есть карта с таким цветом.
     bool haveMatchingColor(UnoPlayer * player, CardColor color);
+
+    // Домашние правила ( @see HouseRules ). Игроки партии — setPlayers.
+
+    /// @return true, если у игрока на руках есть карта со значением `value`.
+    bool haveMatchingValue(UnoPlayer * player, int value);
+    /// @brief Опрашивает игроков партии в порядке хода, начиная со
+    /// следующего за активным, у которых есть такая же карта, как `card`.
+    /// @return номер первого вмешавшегося игрока или -1; его карта с руки
+    /// записывается в `jumpCard`.
+    int findJumpIn(const Card * card, const Card *& jumpCard);
+    /// @brief Меняет местами руки игроков и сообщает об этом.
+    void swapHands(int firstPlayer, int secondPlayer);
+    /// @brief Правило 7: активный игрок меняется рукой с выбранным соперником.
+    void swapWithChosenPlayer();
+    /// @brief Правило 0: руки передаются следующему игроку по направлению;
+    /// наблюдатели получают одно событие HandsRotated.
+    void rotateHands();
     
     /// @brief Подсчитывает количество очков (сумма стоимостей карты на руке игрока).
     /// @param playerIndex игрок, чьи очки подсчитываются.
@@ -0,0 +1,413 @@
+#pragma once
+#include "uno_game.h"
+
+/**
+ * Шаблонная реализация партии ( @see UnoGame::runSetImpl ). Включается в
+ * uno_game.cpp и туда, где партия специализируется домашними правилами
+ * ( @see house_rules_game.h ).
+*/
+
+template<typename Decision>
+bool UnoGame::timeDecision(Decision decide)
+{
+    if (!decisionTiming) 
+    {
+        decide();
+        return true;
+    }
+    const std::uint64_t wallStart = wallClockNanoseconds();
+    const std::uint64_t cpuStart = threadCpuNanoseconds();
+    decide();
+    const std::uint64_t cpu = threadCpuNanoseconds() - cpuStart;
+    const std::uint64_t wall = wallClockNanoseconds() - wallStart;
+
+    PlayerInfo& info = playerInfo.at(activePlayerIndex_);
+    info.latency.wall.record(wall);
+    info.latency.cpu.record(cpu);
+    const std::uint64_t spent = decisionBudget.cpuTime ? cpu : wall;
+    info.gameDecisionTime += spent;
+    bool withinBudget = 
+        (decisionBudget.perDecision == 0 || spent <= decisionBudget.perDecision)
+        && (decisionBudget.perGame == 0 
+            || info.gameDecisionTime <= decisionBudget.perGame);
+    if (!withinBudget) ++info.latency.overruns;
+    return withinBudget;
+}
+
+template<class Rules>
+std::tuple<int, int> UnoGame::runSetImpl()
+{
+    // Проверим, что игроков достаточно
+    if (numberOfPlayers() < config_.minPlayers)
+        throw std::underflow_error("Too few players!");
+
+    // Инициализация
+    activePlayerIndex_ = 0;
+    currentSetScore_ = 0;
+    pendingDraw_ = 0;
+    currentDirection_ = GameDirection::Direct;
+    currentTurnNumber_ = 0;
+    
+    ++currentSetNumber_;
+
+    // Подготовка колоды
+    {
+        UNO_PROFILE_PHASE(gameProfile_, SetPhase::PrepareDeck);
+        moveToDeck();
+    }
+
+    // Память прошлой партии больше не нужна: очередь сообщений пуста после
+    // каждого события
+    arena_.reset();
+
+    // Сообщаем о том, что началась партия
+    broadcaster.handleSetStarted(currentSetNumber_);
+    
+    {
+        UNO_PROFILE_PHASE(gameProfile_, SetPhase::PrepareDeck);
+        shuffleDeck();
+    }
+    broadcaster.handleDeckShuffled();
+
+    // Подготовка игроков
+
+    // Список игроков этой партии
+    // из этого списка могут исключаться игроки при дисквалификации
+    auto & set_players = setPlayers;
+    set_players.assign(players.begin(), players.end());
+    seatSetPlayers();
+
+    // Каждому раздаем по 7 карт (по умолчанию)
+    const int initialCards = config_.initialCards;
+    for (UnoPlayer * player : set_players) 
+    {
+        dealCards(player, initialCards);
+        broadcaster.handlePlayerDealt(player->playerIndex(), initialCards);
+    }
+    
+    // В сброс помещается карта из колоды
+    placeFirstCard();
+    if (!topCard()->is_wild()) currentColor_ = topCard()->color;
+    broadcaster.handleFirstCardPlaced(topCard());
+
+    // Если лежит "Обратный ход", то меняется направление игры
+    if (topCard()->value == CardValue::Reverse)
+    {
+        currentDirection_ = GameDirection::Inverse;
+        broadcaster.handleDirectionChanged(currentDirection_);
+    }
+
+    // Должно ли выполняться действие карты действий 
+    // Действие не выполняется для игрока, который ходит после
+    // дисквалифицированного игрока или после игрока, пропустившего ход
+    bool actionShouldApply = true;
+    // Превысил ли активный игрок ограничение времени на решение
+    bool outOfTime = false;
+
+    // Дисквалификация активного игрока, сыгравшего `card`
+    // Возвращает true, если в партии остался один игрок
+    auto disqualifyActivePlayer = [&](const Card * card) {
+        // Считаем его очки и добавляем в текущий выигрыш
+        int score = countHandScore(activePlayerIndex_);
+        int disqualifiedPlayer = activePlayerIndex_;
+        currentSetScore_ += score;
+        // Определяем следующего игрока
+        int tempActivePlayerIndex = nextPlayerIndex();
+        unseatActivePlayer();
+        broadcaster.handlePlayerDisqualified(disqualifiedPlayer, score, card);
+        activePlayerIndex_ = tempActivePlayerIndex;
+        outOfTime = false;
+        return set_players.size() == 1;
+    };
+
+    // Если лежит "Закажи цвет", то первый игрок заказывает цвет. Превысивший
+    // ограничение времени игрок дисквалифицируется сразу, как и при заказе
+    // цвета на своем ходу, и цвет не объявляется
+    bool setOver = false;
+    if (topCard()->value == CardValue::Wild)
+    {
+        decisionRequested(DecisionType::ChangeColor);
+        CardColor newColor;
+        outOfTime = !timeDecision([&]() {
+            UNO_PROFILE_PHASE(gameProfile_, SetPhase::ChangeColor);
+            newColor = activePlayer()->changeColor();
+        });
+        decisionMade(DecisionType::ChangeColor, nullptr, newColor);
+        currentColor_ = newColor;
+        if (outOfTime) setOver = disqualifyActivePlayer(nullptr);
+        else broadcaster.handlePlayerChangedColor(activePlayerIndex_, newColor);
+    }
+    
+    // Действие сыгранной карты, которое не зависит от следующего игрока
+    auto applyPlayedCard = [&](const Card * card) {
+        // Если карта — "Обратный ход", то сменить направление.
+        if (card->value == CardValue::Reverse)
+        {
+            currentDirection_ = currentDirection_ == GameDirection::Direct
+                ? GameDirection::Inverse
+                : GameDirection::Direct;
+            broadcaster.handleDirectionChanged(currentDirection_);
+        }
+        if constexpr (Rules::sevenZero)
+        {
+            if (card->value == 7) swapWithChosenPlayer();
+            else if (card->value == 0) rotateHands();
+        }
+    };
+
+    const unsigned turnsLimit = config_.turnsLimit;
+
+    // Основной игровой цикл
+    while (!setOver)
+    {
+        currentTurnNumber_++;
+        if (turnsLimit > 0 && currentTurnNumber_ >= turnsLimit)
+        {
+            broadcaster.handleTurnsLimitReached();
+            return std::make_tuple(-1, 0);
+        }
+        // Должен ли игрок пропустить ход
+        bool shouldSkip = false;
+        int additionalCards = 0;
+        // Может ли игрок добавить карту к штрафу (правило stacking)
+        bool stacking = false;
+        if constexpr (Rules::stacking)
+        {
+            // Штраф достается только следующему игроку
+            if (!actionShouldApply) pendingDraw_ = 0;
+        }
+        // Применяем действие карты на игрока
+        if (actionShouldApply)
+        {
+            switch (topCard()->value)
+            {
+                case CardValue::Draw2:
+                    shouldSkip = true;
+                    additionalCards = 2;
+                    break;
+                case CardValue::Skip:
+                    shouldSkip = true;
+                    break;
+                case CardValue::WildDraw4:
+                    shouldSkip = true;
+                    additionalCards = 4;
+                    break;
+            }
+        }
+        if constexpr (Rules::stacking)
+        {
+            if (additionalCards > 0)
+            {
+                pendingDraw_ += additionalCards;
+                additionalCards = pendingDraw_;
+                stacking = haveMatchingValue(activePlayer(), topCard()->value);
+                // Игрок, который может добавить к штрафу, ход не пропускает
+                shouldSkip = !stacking;
+            }
+        }
+        // Игрок берет карты пропускает ход
+        if (shouldSkip)
+        {
+            if constexpr (Rules::stacking) pendingDraw_ = 0;
+            if (additionalCards > 0) 
+                dealCards(activePlayer(), additionalCards);
+            broadcaster.handlePlayerDrewAndSkip(activePlayerIndex_, additionalCards);
+            // Переход к следующему игроку
+            activePlayerIndex_ = nextPlayerIndex();
+            // На следующего игрока верхняя карта не действует
+            actionShouldApply = false;
+            continue;
+        }
+        // Карты активного игрока
+        auto & hand = playerInfo.at(activePlayerIndex_).hand;
+
+        const Card * newCard = nullptr;
+
+        // Если игрок может положить карту (или добавить к штрафу), то у него
+        // запрашивается карта
+        if ((Rules::stacking && stacking) || canPlaceCard(activePlayer(), topCard()))
+        {
+            decisionRequested(DecisionType::PlayCard);
+            if (!timeDecision([&]() {
+                UNO_PROFILE_PHASE(gameProfile_, SetPhase::PlayCard);
+                newCard = activePlayer()->playCard();
+            })) outOfTime = true;
+            decisionMade(DecisionType::PlayCard, newCard);
+        }
+        // Если игрок не может положить карту, он тянет еще одну из колоды
+        else 
+        {
+            // Если в колоде и сбросе есть хотя бы одна карта, кроме верхней 
+            // карты сброса
+            if (deck.size() + discardPile.size() > 1)
+            {
+                const Card * additionalCard;
+                // Сколько неподходящих карт вытянуто до подходящей
+                int unplayable = 0;
+                additionalCard = getCardsFromDeck(activePlayer(), 1).at(0);
+                if constexpr (Rules::drawUntilPlayable)
+                {
+                    // Неподходящие карты остаются на руке
+                    while (!additionalCard->is_wild()
+                        && additionalCard->color != currentColor_
+                        && additionalCard->value != topCard()->value
+                        && deck.size() + discardPile.size() > 1)
+                    {
+                        additionalCard = getCardsFromDeck(activePlayer(), 1).at(0);
+                        ++unplayable;
+                    }
+                }
+                if (unplayable > 0) 
+                    broadcaster.handlePlayerDealt(activePlayerIndex_, unplayable);
+                // Спрашиваем игрока, хочет ли он такую карту положить
+                decisionRequested(DecisionType::DrawAdditionalCard, additionalCard);
+                bool place;
+                if (!timeDecision([&]() {
+                    UNO_PROFILE_PHASE(gameProfile_, SetPhase::DrawAdditionalCard);
+                    place = activePlayer()->drawAdditionalCard(additionalCard);
+                })) outOfTime = true;
+                decisionMade(DecisionType::DrawAdditionalCard, 
+                    place ? additionalCard : nullptr);
+                // Если да, то кладем ее
+                if (place) newCard = additionalCard;
+                // Если нет, то игрок пропускает ход
+                else shouldSkip = true;
+            }
+            // Если игроку неоткуда тянуть карту, то он просто пропускает ход
+            else shouldSkip = true;
+            broadcaster.handlePlayerDrewAnotherCard(activePlayerIndex_);
+        }
+        if (shouldSkip && !outOfTime) 
+        {
+            activePlayerIndex_ = nextPlayerIndex();
+            actionShouldApply = false;
+            continue;
+        }
+        if constexpr (Rules::stacking)
+        {
+            // Добавить к штрафу можно только картой того же значения, иначе
+            // игрок берет штраф и пропускает ход
+            if (stacking && !outOfTime 
+                && (newCard == nullptr || newCard->value != topCard()->value))
+            {
+                dealCards(activePlayer(), pendingDraw_);
+                broadcaster.handlePlayerDrewAndSkip(activePlayerIndex_, pendingDraw_);
+                pendingDraw_ = 0;
+                activePlayerIndex_ = nextPlayerIndex();
+                actionShouldApply = false;
+                continue;
+            }
+        }
+
+        // Пытаемся найти карту, которую положил игрок у него на руках
+        
+        // Итератор, указывающий на карту в руке игрока или hand.end(), если 
+        // такой карты нет.
+        auto handEntry = std::find_if(
+            hand.begin(), hand.end(), 
+            [newCard](const Card * card) { 
+                return newCard != nullptr
+                    && card->color == newCard->color 
+                    && card->value == newCard->value;
+            }); 
+        bool shouldDisqualify = outOfTime
+            || newCard == nullptr 
+            || !newCard->is_valid()
+            || handEntry == hand.end()  // такой карты у него на руках нет
+            || (!(Rules::stacking && stacking)
+                && haveMatchingColor(activePlayer(), currentColor_) 
+                && newCard->value == CardValue::WildDraw4)
+            || (!newCard->is_wild()
+                && newCard->value != topCard()->value 
+                && newCard->color != currentColor_);
+        
+        if (shouldDisqualify)
+        {
+            if (disqualifyActivePlayer(newCard)) break;
+            actionShouldApply = false;
+            continue;
+        }
+
+        newCard = *handEntry;
+        // Положить newCard в discardPile.
+        discardPile.push_back(newCard);
+        
+        // Убрать из руки игрока newCard.
+        hand.erase(handEntry);
+        handChanged(activePlayerIndex_);
+
+        if (!newCard->is_wild()) currentColor_ = newCard->color;
+
+        broadcaster.handleCardPlayed(activePlayerIndex_, newCard);
+        
+        // Если у игрока не осталось карт — выйти из цикла
+        if (hand.empty()) break;
+
+        // Если newCard — дикая, то спросить новый цвет
+        if (newCard->is_wild()) 
+        {
+            decisionRequested(DecisionType::ChangeColor);
+            CardColor newColor;
+            outOfTime = !timeDecision([&]() {
+                UNO_PROFILE_PHASE(gameProfile_, SetPhase::ChangeColor);
+                newColor = activePlayer()->changeColor();
+            });
+            decisionMade(DecisionType::ChangeColor, nullptr, newColor);
+            currentColor_ = newColor;
+            // Карта уже сыграна, поэтому игрок дисквалифицируется сразу
+            if (outOfTime)
+            {
+                if (disqualifyActivePlayer(newCard)) break;
+                actionShouldApply = false;
+                continue;
+            }
+            broadcaster.handlePlayerChangedColor(activePlayerIndex_, newColor);
+        }
+
+        applyPlayedCard(newCard);
+
+        if constexpr (Rules::jumpIn)
+        {
+            // Вмешавшийся игрок кладет такую же карту и ходит вместо
+            // активного; вмешаться можно и в его ход
+            const Card * jumpCard;
+            int jumper;
+            bool won = false;
+            while (!newCard->is_wild() && (jumper = findJumpIn(newCard, jumpCard)) >= 0)
+            {
+                activePlayerIndex_ = jumper;
+                auto & jumperHand = playerInfo.at(jumper).hand;
+                jumperHand.erase(std::find(jumperHand.begin(), jumperHand.end(), jumpCard));
+                handChanged(jumper);
+                discardPile.push_back(jumpCard);
+                broadcaster.handleCardPlayed(jumper, jumpCard);
+                if (jumperHand.empty()) 
+                {
+                    won = true;
+                    break;
+                }
+                // Штраф перекрытой карты переходит к следующему игроку вместе
+                // со штрафом карты вмешавшегося (дикие карты не перекрываются)
+                if constexpr (Rules::stacking)
+                    if (newCard->value == CardValue::Draw2) pendingDraw_ += 2;
+                newCard = jumpCard;
+                applyPlayedCard(newCard);
+            }
+            if (won) break;
+        }
+
+        // Перейти к следующему игроку 
+        activePlayerIndex_ = nextPlayerIndex();
+        actionShouldApply = true;
+    }
+    // Для всех игроков в set_players посчитать очки
+    for (UnoPlayer * player : set_players)
+    {
+        if (activePlayerIndex_ == player->playerIndex()) continue;
+        currentSetScore_ += countHandScore(player->playerIndex());
+    }
+    scores_.at(activePlayerIndex_) += currentSetScore_;
+    // вернуть итоги
+    broadcaster.handlePlayerWonSet(activePlayerIndex_, currentSetScore_);
+    return std::make_tuple(activePlayerIndex_, currentSetScore_);
+}
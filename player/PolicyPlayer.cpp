@@ -0,0 +1,53 @@
+#include "PolicyPlayer.h"
+
+#include <stdexcept>
+
+PolicyPlayer::PolicyPlayer(BatchEvaluator& evaluator, const std::string& name_):
+	playerName(name_), evaluator(evaluator) 
+{
+	// Вычислитель читает из буферов игрока столько, сколько требует модель
+	const PolicyModel& policy = evaluator.policy();
+	if (policy.inputSize() != FeatureLayout::SIZE)
+		throw std::invalid_argument("Policy input size does not match the feature layout");
+	if (policy.outputSize() != ActionSpace::SIZE)
+		throw std::invalid_argument("Policy output size does not match the action space");
+}
+
+std::string PolicyPlayer::name() const { return playerName; }
+
+void PolicyPlayer::receiveCards(CardSpan cards) {}
+
+int PolicyPlayer::decide(DecisionType type, const Card* offered) {
+	CardSpan hand = myHand();
+	encodeDecision(*game(), playerIndex(), hand.begin(), hand.end(), type, features);
+	if (legalActions(*game(), hand.begin(), hand.end(), type, offered, mask) == 0)
+		return -1;
+	return evaluator.evaluate(features, mask);
+}
+
+const Card* PolicyPlayer::playCard() {
+	int action = decide(DecisionType::PlayCard, nullptr);
+	CardSpan hand = myHand();
+	auto it = std::find_if(hand.begin(), hand.end(),
+		[action](const Card* card) { return card->kind() == action; });
+	// Политика ошиблась: кладем первую допустимую карту
+	if (it == hand.end())
+		it = std::find_if(hand.begin(), hand.end(),
+			[this](const Card* card) { return mask[card->kind()] != 0; });
+	if (it == hand.end()) return nullptr;
+	return *it;
+}
+
+bool PolicyPlayer::drawAdditionalCard(const Card* additionalCard) {
+	// Вытянутая карта уже лежит на руке и кодируется вместе с ней
+	// (см. FeatureLayout)
+	int action = decide(DecisionType::DrawAdditionalCard, additionalCard);
+	return action == additionalCard->kind();
+}
+
+CardColor PolicyPlayer::changeColor() {
+	int action = decide(DecisionType::ChangeColor, nullptr);
+	if (action < ActionSpace::COLORS || action >= ActionSpace::PASS)
+		return CardColor::Red;
+	return (CardColor)(action - ActionSpace::COLORS);
+}
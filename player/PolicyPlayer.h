@@ -0,0 +1,39 @@
+#pragma once
+#include "uno_game.h"
+#include "../utils/decision_features.h"
+#include "../utils/policy.h"
+
+/**
+ * @brief Игрок, принимающий решения с помощью обученной политики.
+ *
+ * @details Для каждого решения игрок кодирует публичное состояние игры и свою
+ * руку (см. encodeDecision), строит маску допустимых действий и отправляет
+ * запрос в общий BatchEvaluator. Если политика вернула недопустимое действие,
+ * игрок кладет первую подходящую карту. За столом может быть не больше
+ * FeatureLayout::SEATS игроков, иначе решения бросают std::invalid_argument.
+*/
+class PolicyPlayer : public UnoPlayer
+{
+	std::string playerName;
+	BatchEvaluator& evaluator;
+
+	float features[FeatureLayout::SIZE];
+	std::uint8_t mask[ActionSpace::SIZE];
+
+	/// @brief Запрашивает у политики действие для решения `type`.
+	int decide(DecisionType type, const Card* offered);
+public:
+	/// @throws std::invalid_argument если вход или выход политики не совпадает
+	/// с FeatureLayout::SIZE или ActionSpace::SIZE.
+	PolicyPlayer(BatchEvaluator& evaluator, const std::string& name_ = "PolicyBot");
+
+	std::string name() const;
+
+	void receiveCards(CardSpan cards);
+
+	const Card* playCard();
+
+	bool drawAdditionalCard(const Card* additionalCard);
+
+	CardColor changeColor();
+};
@@ -1,36 +1,38 @@
 #include "Pudge_player.h"
 #include <iostream>
-Player::Player(const std::string& name_): hand(), playerName(name_) {}
+std::vector<double> Player::defaultParams() {
+	return { 3, 2, 1, 0, 1, 0 };
+}
 
-std::string Player::name() const {
-	// Providing a seed value
-	srand((unsigned)time(NULL));
+Player::Player(const std::string& name_, const std::vector<double>& params_):
+	playerName(name_), params(params_), random(std::random_device()()) {
+	if (params.size() != NUMBER_OF_PARAMS)
+		throw std::invalid_argument("Invalid number of Pudge parameters");
+}
 
-	return nameMsgs[rand() % size(nameMsgs)];
+std::string Player::name() const {
+	return nameMsgs[random() % size(nameMsgs)];
 }
 
-//      "".
-void Player::handleSetStarted(int gameNumber) {
-	hand.clear();
+void Player::seed(unsigned value) {
+	random.seed(value);
 }
 
-/// @brief     .
+/// @brief     .    (. myHand).
 /// @param cards  .
-void Player::receiveCards(const std::vector<const Card*>& cards) {
-	for (auto & card : cards) {
-		hand.push_back(card);
-	}
-}
+void Player::receiveCards(CardSpan cards) {}
 
 /// @brief   ,    (  ).
 /// @return ,     .
 const Card* Player::playCard() {
 	//,      ,      .
-	std::vector<const Card*> moves;
-	std::vector<const Card*> movesWild;
-	std::vector<const Card*> movesWild4;
+	//      ,    .
+	ArenaVector<const Card*> moves(arena());
+	ArenaVector<const Card*> movesWild(arena());
+	ArenaVector<const Card*> movesWild4(arena());
 	bool canPlayWild4 = true; // ,     
 							  //  Wild Draw 4.
+	CardSpan hand = myHand();
 
 	//     ,    .
 	const Card* curCard = game()->topCard();
@@ -53,39 +55,22 @@ const Card* Player::playCard() {
 			moves.push_back(hand[i]);
 		}
 	}
-	//   seed.    rand().
-	srand((unsigned)time(NULL));
-
-	//   ,          ,
-	//   .
-	if (!moves.empty()) {
-		//       moves.
-		const Card* elem = moves[rand() % moves.size()];
-		//     .
-		removeV(hand, elem);
-
-		return elem;
-	}
-	//   ,          ,
-	//     " ",   .
-	else if (!movesWild.empty()) {
-		//       movesWild.
-		const Card* elem = movesWild[rand() % movesWild.size()];
-		//     .
-		removeV(hand, elem);
-
-		return elem;
-	}
-	//       ,    "Wild Draw 4".
-	else if (!movesWild4.empty() and canPlayWild4) {
-		//       movesWild4.
-		const Card* elem = movesWild4[rand() % movesWild4.size()];
-		//     .
-		removeV(hand, elem);
-
-		return elem;
+	//  :  , " "  "Wild Draw 4".
+	// "Wild Draw 4"  ,      .
+	const ArenaVector<const Card*>* categories[3] = { &moves, &movesWild, &movesWild4 };
+	const bool allowed[3] = { true, true, canPlayWild4 };
+
+	//         .
+	int best = -1;
+	for (int c = 0; c < 3; c++) {
+		if (categories[c]->empty() or !allowed[c]) continue;
+		if (best < 0 or params[MatchingPriority + c] > params[MatchingPriority + best]) {
+			best = c;
+		}
 	}
+	if (best < 0) return nullptr;
 
+	return (*categories[best])[random() % categories[best]->size()];
 }
 
 bool Player::drawAdditionalCard(const Card* additionalCard) {
@@ -96,29 +81,39 @@ bool Player::drawAdditionalCard(const Card* additionalCard) {
 	
 	//              ,
 	//    .
-	if ((additionalCard->color == curColor) or (additionalCard->value == curValue)) {
+	//     AcceptThreshold ,   .
+	//         .
+	if (((additionalCard->color == curColor) or (additionalCard->value == curValue))
+		and myHand().size() - 1 >= params[AcceptThreshold]) {
 		return true;
 	}
-	//   ,     .
-	hand.push_back(additionalCard);
+	//        .
 	return false;
 }
 
 // ,  ,       .
 CardColor Player::mostCardsColor() {
-	// ,        .
+	// ,       .
 	int cardsColor[4]{};
+	int scoreColor[4]{};
+	CardSpan hand = myHand();
 
-	//      .
+	//      .     .
 	for (int i = 0; i < hand.size(); i++) {
+		if (hand[i]->is_wild()) continue;
 		cardsColor[hand[i]->color] += 1;
+		scoreColor[hand[i]->color] += hand[i]->getScore();
 	}
 
-	// ,       .
-	int mColor = -1000;
+	//    .
+	int mColor = 0;
+	double mValue = 0;
 	for (int i = 0; i < 4; i++) {
-		if (cardsColor[i] > mColor) {
+		double value = params[ColorCountWeight] * cardsColor[i]
+			+ params[ColorScoreWeight] * scoreColor[i] / 10.0;
+		if (i == 0 or value > mValue) {
 			mColor = i;
+			mValue = value;
 		}
 	}
 
@@ -131,20 +126,8 @@ CardColor Player::changeColor() {
 
 
 void Player::handlePlayerWonSet(int playerIndex, int score) {
-	// Providing a seed value
-	srand((unsigned)time(NULL));
-
-	say(winMsgs[rand() % size(winMsgs)]);
+	say(winMsgs[random() % size(winMsgs)]);
 }
 void Player::handlePlayerWonGame(int playerIndex, int totalScore) {
-	// Providing a seed value
-	srand((unsigned)time(NULL));
-
-	say(winMsgs[rand() % size(winMsgs)]);
+	say(winMsgs[random() % size(winMsgs)]);
 }
-
-void removeV(std::vector<const Card*>& arr, const Card* elem) {
-	auto it = std::find(arr.begin(), arr.end(), elem);
-	if (it != arr.end())
-		arr.erase(it);
-}
\ No newline at end of file
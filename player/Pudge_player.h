@@ -1,4 +1,5 @@
 #pragma once
+#include <random>
 #include "uno_game.h"
 
 const std::string nameMsgs[] = {
@@ -41,18 +42,52 @@ const std::string reactionMsgs[] = {
 
 class Player : public UnoPlayer
 {
-    std::vector<const Card*> hand;
+public:
+    /// @brief      .
+    enum Param
+    {
+        MatchingPriority = 0, //  ,     .
+        WildPriority,         //   " ".
+        WildDraw4Priority,    //   " 4".
+        AcceptThreshold,      //   ,   
+                              //      .
+        ColorCountWeight,     //       .
+        ColorScoreWeight,     //     (  ).
+        NUMBER_OF_PARAMS
+    };
+
+    /// @return ,      : 
+    ///  ,  " ",  " 4"; 
+    ///    ;  , 
+    ///    .
+    static std::vector<double> defaultParams();
+
+private:
     std::string playerName;
+    std::vector<double> params;
+    /// @brief   :  ,   .
+    ///      name(),  mutable.
+    mutable std::mt19937 random;
 public:
-    Player(const std::string& name_ = "Pudge");
+    /// @param params_     NUMBER_OF_PARAMS.
+    /// @throws std::invalid_argument    .
+    Player(
+        const std::string& name_ = "Pudge",
+        const std::vector<double>& params_ = defaultParams());
+
+    /// @return  .
+    const std::vector<double>& parameters() const { return params; }
 
 	/// @brief    .
     /// @return  .
     std::string name() const;
+
+    /// @brief    ;    .
+    void seed(unsigned value);
     
     /// @brief     .
     /// @param cards  .
-    void receiveCards(const std::vector<const Card*>& cards);
+    void receiveCards(CardSpan cards);
 
     /// @brief   ,    (  ).
     /// @return ,     .
@@ -68,14 +103,12 @@ public:
     ///      .
     /// @return  .
     CardColor changeColor();
+
+    /// @brief     :    
+    ///   ColorCountWeight      ColorScoreWeight.
     CardColor mostCardsColor();
 
 
     void handlePlayerWonSet(int playerIndex, int score);
     void handlePlayerWonGame(int playerIndex, int totalScore);
-
-    void handleSetStarted(int gameNumber);
-
-};
-
-void removeV(std::vector<const Card*>& arr, const Card* elem);
\ No newline at end of file
+};
\ No newline at end of file
@@ -1,29 +1,25 @@
 #include "RandomBot.h"
 
-RandomBot::RandomBot(const std::string& name_): hand(), BotName(name_) {}
+RandomBot::RandomBot(const std::string& name_): 
+	BotName(name_), random(std::random_device()()) {}
 
 std::string RandomBot::name() const { return BotName; }
 
-void RandomBot::handleSetStarted(int gameNumber) {
-	hand.clear();
-}
+void RandomBot::seed(unsigned value) { random.seed(value); }
 
-void RandomBot::receiveCards(const std::vector<const Card*>& cards) {
-	for (auto & card : cards) {
-		hand.push_back(card);
-	}
-}
+void RandomBot::receiveCards(CardSpan cards) {}
 
 const Card* RandomBot::playCard() {
-	std::vector<const Card*> moves;
-	std::vector<const Card*> movesWild4;
+	ArenaVector<const Card*> moves(arena());
+	ArenaVector<const Card*> movesWild4(arena());
 	bool canPlayWild4 = true; 
+	CardSpan hand = myHand();
 
 	const Card* curCard = game()->topCard();
 	CardColor curColor = game()->currentColor();
 	int curValue = curCard->value; 
 
-	for (int i = 0; i < hand.size(); i++) {
+	for (size_t i = 0; i < hand.size(); i++) {
 		if (hand[i]->value == WildDraw4) {
 			movesWild4.push_back(hand[i]);
 		}
@@ -37,19 +33,13 @@ const Card* RandomBot::playCard() {
 		
 	}
 
-	srand((unsigned)time(NULL));
-	
 	if (!moves.empty()) {
-		const Card* elem = moves[rand() % moves.size()];
-		removeVV(hand, elem);
-		return elem;
+		return moves[random() % moves.size()];
 	}
 	else if (!movesWild4.empty() and canPlayWild4) {
-		const Card* elem = movesWild4[rand() % movesWild4.size()];
-		removeVV(hand, elem);
-		return elem;
+		return movesWild4[random() % movesWild4.size()];
 	}
-
+	return nullptr;
 }
 
 bool RandomBot::drawAdditionalCard(const Card* additionalCard) {
@@ -57,25 +47,42 @@ bool RandomBot::drawAdditionalCard(const Card* additionalCard) {
 	const CardColor curColor = game()->currentColor();
 	const int curValue = curCard->value;
 
-	if (rand() % 2 == 0) {
+	if (random() % 2 == 0) {
 		if ((additionalCard->color == curColor) or (additionalCard->value == curValue)) {
 			return true;
 		}
 	}
-	hand.push_back(additionalCard);
 	return false;
 }
 	
 
 
 CardColor RandomBot::changeColor() {
-	int mColor = rand() % 4;
+	int mColor = random() % 4;
 	return (CardColor)mColor;
 }
 
+const Card* RandomBot::jumpIn(const Card* card) {
+	for (const Card* c : myHand()) {
+		if (c->color == card->color and c->value == card->value) {
+			return c;
+		}
+	}
+	return nullptr;
+}
 
-void removeVV(std::vector<const Card*>& arr, const Card* elem) {
-	auto it = std::find(arr.begin(), arr.end(), elem);
-	if (it != arr.end())
-		arr.erase(it);
+int RandomBot::chooseSwapPlayer() {
+	// Соперник выбирается равновероятно среди оставшихся в партии
+	const int players = game()->numberOfPlayers();
+	int opponents = 0;
+	for (int i = 0; i < players; i++) {
+		if (i != playerIndex() and game()->inSet(i)) opponents++;
+	}
+	if (opponents == 0) return -1;
+	int chosen = random() % opponents;
+	for (int i = 0; i < players; i++) {
+		if (i == playerIndex() or !game()->inSet(i)) continue;
+		if (chosen-- == 0) return i;
+	}
+	return -1;
 }
\ No newline at end of file
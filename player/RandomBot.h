@@ -1,16 +1,20 @@
 #pragma once
+#include <random>
 #include "uno_game.h"
 
 class RandomBot : public UnoPlayer
 {
-    std::vector<const Card*> hand;
     std::string BotName;
+    std::mt19937 random;
 public:
     RandomBot(const std::string& name_ = "RandomBot");
 
     std::string name() const;
+
+    /// @brief Задает сид генератора бота; по умолчанию сид случайный.
+    void seed(unsigned value);
     
-    void receiveCards(const std::vector<const Card*>& cards);
+    void receiveCards(CardSpan cards);
 
     const Card* playCard();
 
@@ -18,7 +22,7 @@ public:
 
     CardColor changeColor();
 
-    void handleSetStarted(int gameNumber);
-};
+    const Card* jumpIn(const Card* card);
 
-void removeVV(std::vector<const Card*>& arr, const Card* elem);
\ No newline at end of file
+    int chooseSwapPlayer();
+};
\ No newline at end of file
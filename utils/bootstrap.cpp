@@ -0,0 +1,141 @@
+#include "bootstrap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+#include "parallel.h"
+
+BootstrapInterval bootstrapMean(
+    const std::vector<int> &values,
+    const std::vector<std::uint64_t> &counts,
+    const BootstrapConfig &config)
+{
+    if (values.size() != counts.size())
+        throw std::invalid_argument("Every value must have a count");
+    if (config.resamples <= 1 || config.confidence <= 0 || config.confidence >= 1)
+        throw std::invalid_argument("Invalid bootstrap parameters");
+    std::uint64_t total = 0;
+    double sum = 0;
+    for (size_t k = 0; k < values.size(); ++k)
+    {
+        total += counts[k];
+        sum += static_cast<double>(values[k]) * counts[k];
+    }
+    if (total == 0) throw std::invalid_argument("Nothing to resample");
+
+    std::vector<double> means(config.resamples);
+    parallelFor(config.resamples, config.threads, 64, [&](int, std::uint64_t r) {
+        // Своя последовательность для каждой выборки — результат не зависит
+        // от распределения выборок по потокам
+        std::seed_seq seq{ config.seed, static_cast<unsigned>(r) };
+        std::mt19937_64 random(seq);
+        std::uint64_t left = total, taken = 0;
+        double resampled = 0;
+        for (size_t k = 0; k + 1 < values.size() && left > 0; ++k)
+        {
+            const double p = static_cast<double>(counts[k]) / (total - taken);
+            std::binomial_distribution<std::uint64_t> binomial(left, std::min(p, 1.0));
+            const std::uint64_t count = binomial(random);
+            resampled += static_cast<double>(values[k]) * count;
+            left -= count;
+            taken += counts[k];
+        }
+        resampled += static_cast<double>(values.back()) * left;
+        means[r] = resampled / total;
+    });
+
+    BootstrapInterval interval;
+    interval.estimate = sum / total;
+    double mean = 0, square = 0;
+    for (double m : means) mean += m;
+    mean /= means.size();
+    for (double m : means) square += (m - mean) * (m - mean);
+    interval.standardError = std::sqrt(square / (means.size() - 1));
+
+    std::sort(means.begin(), means.end());
+    const double tail = (1 - config.confidence) / 2;
+    auto quantile = [&](double q) {
+        const double position = q * (means.size() - 1);
+        const size_t below = static_cast<size_t>(position);
+        const size_t above = std::min(below + 1, means.size() - 1);
+        return means[below] + (position - below) * (means[above] - means[below]);
+    };
+    interval.lower = quantile(tail);
+    interval.upper = quantile(1 - tail);
+    return interval;
+}
+
+/// @brief Строит гистограмму величины `value(game)` по всем играм.
+template<class F>
+static BootstrapInterval bootstrapGames(
+    const GameResults& results, const BootstrapConfig& config, F value)
+{
+    const size_t games = results.size();
+    if (games == 0) throw std::invalid_argument("Nothing to resample");
+    int low = value(0), high = low;
+    for (size_t g = 1; g < games; ++g)
+    {
+        const int v = value(g);
+        low = std::min(low, v);
+        high = std::max(high, v);
+    }
+    // Величины — очки и их разности, так что плотный массив невелик
+    std::vector<std::uint64_t> dense(static_cast<size_t>(high - low) + 1, 0);
+    for (size_t g = 0; g < games; ++g) ++dense[value(g) - low];
+
+    std::vector<int> values;
+    std::vector<std::uint64_t> counts;
+    for (size_t k = 0; k < dense.size(); ++k)
+        if (dense[k] > 0)
+        {
+            values.push_back(low + static_cast<int>(k));
+            counts.push_back(dense[k]);
+        }
+    return bootstrapMean(values, counts, config);
+}
+
+static void checkPlayer(const GameResults& results, int player)
+{
+    if (player < 0 || player >= results.players())
+        throw std::invalid_argument("Invalid player index");
+}
+
+BootstrapInterval bootstrapWinRate(
+    const GameResults &results, int player, const BootstrapConfig &config)
+{
+    checkPlayer(results, player);
+    return bootstrapGames(results, config, [&](size_t g) {
+        return results.winner(g) == player ? 1 : 0;
+    });
+}
+
+BootstrapInterval bootstrapMeanScore(
+    const GameResults &results, int player, const BootstrapConfig &config)
+{
+    checkPlayer(results, player);
+    return bootstrapGames(results, config, [&](size_t g) {
+        return results.score(g, player);
+    });
+}
+
+BootstrapInterval bootstrapWinRateDifference(
+    const GameResults &results, int i, int j, const BootstrapConfig &config)
+{
+    checkPlayer(results, i);
+    checkPlayer(results, j);
+    return bootstrapGames(results, config, [&](size_t g) {
+        return (results.winner(g) == i ? 1 : 0) - (results.winner(g) == j ? 1 : 0);
+    });
+}
+
+BootstrapInterval bootstrapScoreDifference(
+    const GameResults &results, int i, int j, const BootstrapConfig &config)
+{
+    checkPlayer(results, i);
+    checkPlayer(results, j);
+    return bootstrapGames(results, config, [&](size_t g) {
+        return results.score(g, i) - results.score(g, j);
+    });
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "game_results.h"
+
+/// @brief Параметры бутстрепа.
+struct BootstrapConfig
+{
+    /// @brief Число повторных выборок.
+    int resamples = 10000;
+    /// @brief Уровень доверия интервала.
+    double confidence = 0.95;
+    /// @brief Число потоков, 0 — по числу ядер.
+    int threads = 0;
+    /// @brief Сид; результат не зависит от числа потоков.
+    unsigned seed = 0;
+};
+
+/// @brief Процентильный бутстреп-интервал.
+struct BootstrapInterval
+{
+    /// @brief Значение статистики на исходной выборке.
+    double estimate = 0;
+    double lower = 0, upper = 0;
+    /// @brief Стандартное отклонение статистики по повторным выборкам.
+    double standardError = 0;
+};
+
+/**
+ * @brief Бутстреп среднего целочисленной величины, заданной гистограммой:
+ * значение `values[k]` встретилось `counts[k]` раз.
+ * @details Повторная выборка с возвращением из N игр — это мультиномиальное
+ * распределение частот значений, поэтому каждая выборка строится за
+ * O(числа различных значений) последовательными биномиальными
+ * розыгрышами, а не за O(N). Выборки распределяются между потоками.
+ * @throws std::invalid_argument если гистограмма пуста или параметры
+ * некорректны.
+*/
+BootstrapInterval bootstrapMean(
+    const std::vector<int>& values,
+    const std::vector<std::uint64_t>& counts,
+    const BootstrapConfig& config = BootstrapConfig());
+
+/// @brief Интервал для доли побед игрока `player`.
+BootstrapInterval bootstrapWinRate(
+    const GameResults& results, int player,
+    const BootstrapConfig& config = BootstrapConfig());
+
+/// @brief Интервал для средних очков игрока `player`.
+BootstrapInterval bootstrapMeanScore(
+    const GameResults& results, int player,
+    const BootstrapConfig& config = BootstrapConfig());
+
+/// @brief Парный интервал для разности долей побед игроков `i` и `j`: игры
+/// выбираются целиком, поэтому учитывается зависимость результатов в одной игре.
+BootstrapInterval bootstrapWinRateDifference(
+    const GameResults& results, int i, int j,
+    const BootstrapConfig& config = BootstrapConfig());
+
+/// @brief Парный интервал для средней разности очков игроков `i` и `j`.
+BootstrapInterval bootstrapScoreDifference(
+    const GameResults& results, int i, int j,
+    const BootstrapConfig& config = BootstrapConfig());
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "../game/uno_game.h"
+
+/**
+ * @brief Раскладка вектора признаков решения. Все смещения даны в элементах
+ * вектора, размер вектора — `SIZE`.
+ *
+ * @details Места игроков отсчитываются относительно принимающего решение
+ * игрока: место 0 — он сам, место 1 — следующий за ним по списку и т.д.
+ * Хвост вектора после `DECISION` заполняется нулями, чтобы размер был кратен
+ * ширине векторных регистров.
+ *
+ * Признаки кодируются в `float` или в `std::int8_t` (см. FeatureScale).
+ * Количества карт в обоих случаях записываются как есть, очки и размер колоды
+ * масштабируются по-разному. Для решения `DrawAdditionalCard` вытянутая карта
+ * уже считается картой на руке.
+*/
+struct FeatureLayout
+{
+    /// @brief Максимальное число мест за столом, которое кодируется.
+    static constexpr int SEATS = 10;
+
+    /// @brief Количество карт каждого вида на руке.
+    static constexpr int HAND         = 0;
+    /// @brief Вид верхней карты сброса (one-hot).
+    static constexpr int TOP_CARD     = HAND + NUMBER_OF_CARD_KINDS;
+    /// @brief Текущий цвет (one-hot).
+    static constexpr int COLOR        = TOP_CARD + NUMBER_OF_CARD_KINDS;
+    /// @brief 1, если направление игры обратное.
+    static constexpr int DIRECTION    = COLOR + 4;
+    /// @brief Количество карт у игроков по местам.
+    static constexpr int CARDS_NUMBER = DIRECTION + 1;
+    /// @brief Очки игроков по местам.
+    static constexpr int SCORES       = CARDS_NUMBER + SEATS;
+    /// @brief Количество карт в колоде.
+    static constexpr int CARDS_LEFT   = SCORES + SEATS;
+    /// @brief Тип решения (one-hot по DecisionType).
+    static constexpr int DECISION     = CARDS_LEFT + 1;
+
+    /// @brief Размер вектора признаков.
+    static constexpr int SIZE = 144;
+};
+
+static_assert(FeatureLayout::DECISION + 3 <= FeatureLayout::SIZE,
+    "Feature layout does not fit");
+
+/**
+ * @brief Пространство действий политики.
+ *
+ * @details Действия [0; NUMBER_OF_CARD_KINDS) — сыграть карту этого вида
+ * (см. Card::kind), действия [COLORS; COLORS + 4) — заказать цвет,
+ * `PASS` — оставить вытянутую карту себе.
+*/
+struct ActionSpace
+{
+    static constexpr int COLORS = NUMBER_OF_CARD_KINDS;
+    static constexpr int PASS   = COLORS + 4;
+    static constexpr int SIZE   = PASS + 1;
+};
+
+/// @return можно ли положить карту `card` на `topCard` при текущем цвете `color`.
+/// @param haveMatchingColor есть ли у игрока на руках карта текущего цвета;
+/// если есть, то "Возьми 4" класть нельзя.
+inline bool isLegalCard(
+    const Card * card,
+    const Card * topCard,
+    CardColor color,
+    bool haveMatchingColor)
+{
+    if (card->value == CardValue::WildDraw4) return !haveMatchingColor;
+    if (card->is_wild()) return true;
+    return card->color == color || card->value == topCard->value;
+}
+
+/// @brief Масштабирование признаков для типа элемента `T`.
+template<class T>
+struct FeatureScale;
+
+/// @brief Очки в сотнях, колода — доля от полной колоды.
+template<>
+struct FeatureScale<float>
+{
+    static float count(int n) { return static_cast<float>(n); }
+    static float score(int score) { return score / 100.f; }
+    static float cardsLeft(int n, int deckSize) 
+        { return n / static_cast<float>(deckSize); }
+};
+
+/// @brief Очки в десятках, колода — число карт; значения ограничены 127.
+template<>
+struct FeatureScale<std::int8_t>
+{
+    static std::int8_t clamp(int n) 
+        { return static_cast<std::int8_t>(n < 127 ? n : 127); }
+    static std::int8_t count(int n) { return clamp(n); }
+    static std::int8_t score(int score) { return clamp(score / 10); }
+    static std::int8_t cardsLeft(int n, int deckSize) { return clamp(n); }
+};
+
+/**
+ * @brief Записывает признаки решения игрока в `features`.
+ * @tparam T `float` или `std::int8_t`.
+ * @param game игра, публичное состояние которой кодируется.
+ * @param playerIndex номер принимающего решение игрока.
+ * @param handBegin, handEnd карты на руке игрока (итераторы на `const Card *`).
+ * @param type тип решения.
+ * @param features буфер размера `FeatureLayout::SIZE`.
+ * @details Функция не выделяет динамическую память.
+ * @throws std::invalid_argument, если за столом больше
+ * `FeatureLayout::SEATS` игроков: соперники на дальних местах не
+ * поместились бы в вектор признаков.
+*/
+template<class T, class iterator>
+void encodeDecision(
+    const UnoGame& game,
+    int playerIndex,
+    iterator handBegin,
+    iterator handEnd,
+    DecisionType type,
+    T * features)
+{
+    using Scale = FeatureScale<T>;
+    const int players = game.numberOfPlayers();
+    if (players > FeatureLayout::SEATS)
+        throw std::invalid_argument("Too many players for the feature layout");
+    for (int i = 0; i < FeatureLayout::SIZE; ++i) features[i] = 0;
+
+    int hand[NUMBER_OF_CARD_KINDS] = {};
+    for (; handBegin != handEnd; ++handBegin) ++hand[(*handBegin)->kind()];
+    for (int k = 0; k < NUMBER_OF_CARD_KINDS; ++k)
+        features[FeatureLayout::HAND + k] = Scale::count(hand[k]);
+
+    const Card * top = game.topCard();
+    if (top != nullptr) features[FeatureLayout::TOP_CARD + top->kind()] = 1;
+    features[FeatureLayout::COLOR + game.currentColor()] = 1;
+    features[FeatureLayout::DIRECTION] =
+        game.currentDirection() == GameDirection::Inverse ? 1 : 0;
+
+    for (int seat = 0; seat < players; ++seat)
+    {
+        int i = (playerIndex + seat) % players;
+        features[FeatureLayout::CARDS_NUMBER + seat] = Scale::count(game.cardsOf(i));
+        features[FeatureLayout::SCORES + seat] = Scale::score(game.scoreOf(i));
+    }
+    features[FeatureLayout::CARDS_LEFT] = 
+        Scale::cardsLeft(game.cardsLeft(), game.deckSize());
+    features[FeatureLayout::DECISION + type] = 1;
+}
+
+/// @return действие (см. ActionSpace), соответствующее решению игрока, или -1,
+/// если решение не соответствует ни одному действию.
+/// @see DecisionObserver::handleDecisionMade
+inline int decisionAction(DecisionType type, const Card * card, CardColor color)
+{
+    switch (type)
+    {
+    case DecisionType::ChangeColor:
+        return ActionSpace::COLORS + color;
+    case DecisionType::DrawAdditionalCard:
+        return card == nullptr ? ActionSpace::PASS : card->kind();
+    default:
+        return card == nullptr || !card->is_valid() ? -1 : card->kind();
+    }
+}
+
+/**
+ * @brief Заполняет маску допустимых действий.
+ * @param offered вытянутая карта для решения `DrawAdditionalCard`, для
+ * остальных решений не используется.
+ * @param mask буфер размера `ActionSpace::SIZE`, 1 — действие допустимо.
+ * @return количество допустимых действий.
+*/
+template<class iterator>
+int legalActions(
+    const UnoGame& game,
+    iterator handBegin,
+    iterator handEnd,
+    DecisionType type,
+    const Card * offered,
+    std::uint8_t * mask)
+{
+    for (int i = 0; i < ActionSpace::SIZE; ++i) mask[i] = 0;
+
+    if (type == DecisionType::ChangeColor)
+    {
+        for (int c = 0; c < 4; ++c) mask[ActionSpace::COLORS + c] = 1;
+        return 4;
+    }
+
+    const Card * top = game.topCard();
+    const CardColor color = game.currentColor();
+    bool haveMatchingColor = false;
+    for (iterator it = handBegin; it != handEnd; ++it)
+        if (!(*it)->is_wild() && (*it)->color == color)
+            haveMatchingColor = true;
+
+    int count = 0;
+    if (type == DecisionType::DrawAdditionalCard)
+    {
+        mask[ActionSpace::PASS] = 1;
+        ++count;
+        if (offered != nullptr && isLegalCard(offered, top, color, haveMatchingColor))
+        {
+            mask[offered->kind()] = 1;
+            ++count;
+        }
+        return count;
+    }
+
+    for (; handBegin != handEnd; ++handBegin)
+    {
+        const Card * card = *handBegin;
+        if (mask[card->kind()] || !isLegalCard(card, top, color, haveMatchingColor))
+            continue;
+        mask[card->kind()] = 1;
+        ++count;
+    }
+    return count;
+}
@@ -0,0 +1,152 @@
+#include "duplicate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+DuplicateDealGame::DuplicateDealGame():
+    UnoGame(),
+    dealSeed(0),
+    dealSetNumber(-1),
+    dealKinds(),
+    firstCardAttempts(0)
+{
+    dealKinds.reserve(deckSize());
+}
+
+void DuplicateDealGame::setDealSeed(unsigned seed)
+{
+    dealSeed = seed;
+    dealSetNumber = -1;
+}
+
+void DuplicateDealGame::prepareDeal()
+{
+    if (dealSetNumber == currentSetNumber()) return;
+    // В начале партии все карты находятся в колоде
+    dealKinds.clear();
+    for (const Card * card : getDeck()) dealKinds.push_back(card->kind());
+    std::sort(dealKinds.begin(), dealKinds.end());
+    std::seed_seq seq{ dealSeed, static_cast<unsigned>(currentSetNumber()) };
+    std::mt19937 random(seq);
+    std::shuffle(dealKinds.begin(), dealKinds.end(), random);
+    dealSetNumber = currentSetNumber();
+    firstCardAttempts = 0;
+}
+
+const Card *DuplicateDealGame::takeFromDeck(
+    int kind, const std::vector<const Card*>& taken) const
+{
+    for (const Card * card : getDeck())
+        if (card->kind() == kind
+            && std::find(taken.begin(), taken.end(), card) == taken.end())
+            return card;
+    return nullptr;
+}
+
+std::vector<const Card*> DuplicateDealGame::chooseCards(
+    const UnoPlayer *player, int numberOfCards)
+{
+    // Раздача задается только до того, как выложена первая карта
+    if (topCard() != nullptr) return std::vector<const Card*>();
+    prepareDeal();
+    const size_t first = static_cast<size_t>(player->playerIndex()) * numberOfCards;
+    if (first + numberOfCards > dealKinds.size())
+        return std::vector<const Card*>();
+
+    std::vector<const Card*> hand;
+    hand.reserve(numberOfCards);
+    for (int i = 0; i < numberOfCards; ++i)
+    {
+        const Card * card = takeFromDeck(dealKinds[first + i], hand);
+        if (card == nullptr) return std::vector<const Card*>();
+        hand.push_back(card);
+    }
+    return hand;
+}
+
+const Card *DuplicateDealGame::chooseFirstCard()
+{
+    prepareDeal();
+    const size_t index = static_cast<size_t>(numberOfPlayers())
+        * config().initialCards + firstCardAttempts++;
+    if (index >= dealKinds.size()) return nullptr;
+    return takeFromDeck(dealKinds[index], std::vector<const Card*>());
+}
+
+double DuplicateResult::winRateError(int i) const
+{
+    return std::sqrt(wins.var.at(i).at(i) / deals);
+}
+
+double DuplicateResult::differenceError(int i, int j) const
+{
+    const double var = wins.var.at(i).at(i) + wins.var.at(j).at(j)
+        - 2 * wins.var.at(i).at(j);
+    return std::sqrt(std::max(var, 0.0) / deals);
+}
+
+DuplicateResult runDuplicateGames(
+    DuplicateDealGame &game,
+    int numberOfDeals,
+    bool mirrored,
+    unsigned firstSeed)
+{
+    const int n = game.numberOfPlayers();
+    if (n < 2 || numberOfDeals <= 0)
+        throw std::underflow_error("Nothing to evaluate");
+
+    std::vector<UnoPlayer*> base(n);
+    for (int i = 0; i < n; ++i) base[i] = game.player(i);
+
+    // Все рассадки: циклические сдвиги прямого и, если нужно, обратного порядка
+    std::vector<std::vector<UnoPlayer*>> arrangements;
+    for (int direction = 0; direction < (mirrored ? 2 : 1); ++direction)
+        for (int shift = 0; shift < n; ++shift)
+        {
+            std::vector<UnoPlayer*> order(n);
+            for (int k = 0; k < n; ++k)
+                order[k] = direction == 0
+                    ? base[(k + shift) % n]
+                    : base[(n - k + shift) % n];
+            arrangements.push_back(order);
+        }
+    // При двух игроках обратный порядок совпадает с прямым
+    if (mirrored && n == 2) arrangements.resize(2);
+
+    // Наблюдение — доли побед и очки игроков, усредненные по рассадкам раздачи
+    MomentAccumulator wins(n), scores(n);
+    std::vector<double> dealWins(n), dealScores(n);
+    const double weight = 1.0 / arrangements.size();
+
+    for (int d = 0; d < numberOfDeals; ++d)
+    {
+        const unsigned seed = firstSeed + d;
+        std::fill(dealWins.begin(), dealWins.end(), 0);
+        std::fill(dealScores.begin(), dealScores.end(), 0);
+        for (const auto& order : arrangements)
+        {
+            seatPlayers(game, order);
+            game.setDealSeed(seed);
+            game.setRandomGeneratorSeed(seed);
+            const int winner = std::get<0>(game.runGame());
+            for (int i = 0; i < n; ++i)
+            {
+                const int seat = base[i]->playerIndex();
+                if (seat == winner) dealWins[i] += weight;
+                dealScores[i] += weight * game.scoreOf(seat);
+            }
+        }
+        wins.add(dealWins.begin());
+        scores.add(dealScores.begin());
+    }
+    seatPlayers(game, base);
+
+    DuplicateResult result;
+    result.deals = numberOfDeals;
+    result.gamesPerDeal = arrangements.size();
+    result.wins = StatsObserver::getMV(wins);
+    result.scores = StatsObserver::getMV(scores);
+    return result;
+}
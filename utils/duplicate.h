@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+
+#include "../game/uno_game.h"
+#include "stats.h"
+
+/**
+ * @brief Игра с дублированными раздачами: начальные руки по местам и первая
+ * карта каждой партии зависят только от сида раздачи и номера партии, но не
+ * от того, кто сидит на месте.
+ *
+ * @details Раздача задается через `chooseCards` и `chooseFirstCard`: в начале
+ * партии виды карт полной колоды перемешиваются генератором, зависящим от
+ * сида раздачи и номера партии; место `k` получает виды с `7k` по `7k + 6`,
+ * дальше идут кандидаты на первую карту. Карты, которые берутся во время
+ * партии, выдаются из колоды как обычно.
+*/
+class DuplicateDealGame: public UnoGame
+{
+    unsigned dealSeed;
+    /// @brief Номер партии, для которой построена раздача `dealKinds`.
+    int dealSetNumber;
+    /// @brief Виды карт в порядке раздачи.
+    std::vector<int> dealKinds;
+    /// @brief Сколько видов раздачи уже выложено первой картой.
+    int firstCardAttempts;
+
+    /// @brief Строит раздачу текущей партии, если она еще не построена.
+    void prepareDeal();
+    /// @brief Находит в колоде карту вида `kind`, которой нет в `taken`.
+    const Card * takeFromDeck(int kind, const std::vector<const Card*>& taken) const;
+
+protected:
+    std::vector<const Card*> chooseCards(
+        const UnoPlayer* player,
+        int numberOfCards) override;
+    const Card * chooseFirstCard() override;
+
+public:
+    DuplicateDealGame();
+
+    /// @brief Устанавливает сид раздачи для следующих партий.
+    void setDealSeed(unsigned seed);
+};
+
+/// @brief Итоги дублированной оценки. Номера игроков — их места при вызове
+/// `runDuplicateGames`.
+struct DuplicateResult
+{
+    /// @brief Число раздач.
+    int deals = 0;
+    /// @brief Игр на каждую раздачу (число рассадок).
+    int gamesPerDeal = 0;
+
+    /// @brief Среднее и ковариация доли побед игроков по раздачам; доля побед
+    /// на раздаче — среднее по всем рассадкам этой раздачи.
+    StatsObserver::MV wins;
+    /// @brief Среднее и ковариация очков игроков по раздачам.
+    StatsObserver::MV scores;
+
+    /// @return стандартная ошибка доли побед игрока `i`.
+    double winRateError(int i) const;
+    /// @return стандартная ошибка разности долей побед игроков `i` и `j`,
+    /// посчитанная по парам на одних и тех же раздачах.
+    double differenceError(int i, int j) const;
+};
+
+/**
+ * @brief Дублированная оценка: каждая из `numberOfDeals` раздач
+ * разыгрывается при всех циклических сдвигах рассадки, а если `mirrored`,
+ * то и при всех сдвигах обратного порядка. Результаты сначала усредняются по
+ * раздаче, а потом по раздачам.
+ * @param firstSeed сид первой раздачи; раздача `d` имеет сид `firstSeed + d`.
+ * @details Каждый игрок играет каждую руку каждой раздачи, поэтому удача в
+ * раздаче сокращается при сравнении игроков, и для той же точности нужно
+ * меньше игр, чем в runGames. После оценки игроки рассаживаются как до нее.
+ * @throws std::underflow_error если игроков меньше 2 или раздач нет.
+*/
+DuplicateResult runDuplicateGames(
+    DuplicateDealGame& game,
+    int numberOfDeals,
+    bool mirrored = false,
+    unsigned firstSeed = 0);
@@ -0,0 +1,105 @@
+#include "export.h"
+
+#include <algorithm>
+#include <cstring>
+
+BufferedWriter::BufferedWriter(std::ostream &out, size_t capacity):
+    out(out),
+    buffer(new char[std::max(capacity, MIN_CAPACITY)]),
+    capacity(std::max(capacity, MIN_CAPACITY)),
+    used(0)
+{}
+
+void BufferedWriter::write(const char *data, size_t size)
+{
+    if (size > capacity - used)
+    {
+        flush();
+        // Большие куски передаются потоку без копирования
+        if (size >= capacity)
+        {
+            out.write(data, size);
+            return;
+        }
+    }
+    std::memcpy(buffer.get() + used, data, size);
+    used += size;
+}
+
+void BufferedWriter::flush()
+{
+    if (used == 0) return;
+    out.write(buffer.get(), used);
+    used = 0;
+}
+
+void exportResultsText(const GameResults &results, std::ostream &out, char separator)
+{
+    BufferedWriter writer(out);
+    const int players = results.players();
+    writer.write("Winner", 6);
+    writer.put(separator);
+    writer.write("Sets", 4);
+    writer.put(separator);
+    writer.write("Turns", 5);
+    for (int i = 0; i < players; ++i)
+    {
+        writer.put(separator);
+        writer.write("Player", 6);
+        writer.writeInt(i);
+    }
+    writer.put('\n');
+
+    // Построчный вывод по блокам: внутри блока все столбцы читаются подряд
+    const auto& winners = results.winnersColumn();
+    for (size_t k = 0; k < winners.chunkCount(); ++k)
+    {
+        const std::int16_t * winner = winners.chunk(k);
+        const std::uint16_t * sets = results.setsColumn().chunk(k);
+        const std::uint32_t * turns = results.turnsColumn().chunk(k);
+        const size_t length = winners.chunkLength(k);
+        for (size_t g = 0; g < length; ++g)
+        {
+            writer.writeInt(winner[g]);
+            writer.put(separator);
+            writer.writeInt(sets[g]);
+            writer.put(separator);
+            writer.writeInt(turns[g]);
+            for (int i = 0; i < players; ++i)
+            {
+                writer.put(separator);
+                writer.writeInt(results.scoresColumn(i).chunk(k)[g]);
+            }
+            writer.put('\n');
+        }
+    }
+}
+
+/// @brief Пишет столбец блоками и дополняет его нулями до кратного 8 размера.
+template<class T>
+static void writeColumn(const ChunkedColumn<T>& column, std::ostream& out)
+{
+    for (size_t k = 0; k < column.chunkCount(); ++k)
+        out.write(reinterpret_cast<const char*>(column.chunk(k)),
+            column.chunkLength(k) * sizeof(T));
+    const char zeros[8] = {};
+    const size_t tail = column.size() * sizeof(T) % 8;
+    if (tail != 0) out.write(zeros, 8 - tail);
+}
+
+void exportResultsBinary(const GameResults &results, std::ostream &out)
+{
+    char header[32] = { 'U', 'N', 'O', 'R' };
+    const std::uint32_t players = results.players();
+    const std::uint64_t games = results.size();
+    std::memcpy(header + 4, &RESULTS_FORMAT_VERSION, 4);
+    std::memcpy(header + 8, &players, 4);
+    std::memcpy(header + 16, &games, 8);
+    out.write(header, sizeof(header));
+
+    writeColumn(results.winnersColumn(), out);
+    writeColumn(results.setsColumn(), out);
+    writeColumn(results.turnsColumn(), out);
+    for (int i = 0; i < results.players(); ++i)
+        writeColumn(results.scoresColumn(i), out);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+
+#include "game_results.h"
+
+/**
+ * @brief Буферизованная запись в поток большими блоками с собственным
+ * форматированием целых чисел.
+ * @details Данные копируются в буфер и передаются потоку целиком, когда
+ * буфер заполнен, так что на каждое число не вызываются operator<< и
+ * проверки состояния потока.
+*/
+class BufferedWriter
+{
+    std::ostream& out;
+    std::unique_ptr<char[]> buffer;
+    size_t capacity, used;
+
+public:
+    /// @brief Наименьший размер буфера: в него помещается любое число
+    /// ( @see writeInt ).
+    static constexpr size_t MIN_CAPACITY = 32;
+
+    /// @param capacity размер буфера; меньшие `MIN_CAPACITY` значения
+    /// увеличиваются до него.
+    explicit BufferedWriter(std::ostream& out, size_t capacity = size_t(1) << 20);
+    ~BufferedWriter() { flush(); }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    void put(char c)
+    {
+        if (used == capacity) flush();
+        buffer[used++] = c;
+    }
+
+    void write(const char * data, size_t size);
+
+    /// @brief Записывает целое число в десятичной записи.
+    void writeInt(long long value)
+    {
+        // Самое длинное число — 20 цифр со знаком
+        if (capacity - used < 20) flush();
+        char digits[20];
+        int length = 0;
+        unsigned long long magnitude = value < 0
+            ? 0ull - static_cast<unsigned long long>(value)
+            : static_cast<unsigned long long>(value);
+        do {
+            digits[length++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0) buffer[used++] = '-';
+        while (length > 0) buffer[used++] = digits[--length];
+    }
+
+    /// @brief Передает содержимое буфера потоку.
+    void flush();
+};
+
+/**
+ * @brief Выводит результаты игр построчно с разделителем `separator`
+ * (табуляция — TSV, запятая — CSV).
+ * @details Столбцы: `Winner`, `Sets`, `Turns`, `Player0`…`PlayerN`
+ * (очки игроков). Строки выводятся по играм, значения берутся из блоков
+ * столбцов подряд.
+*/
+void exportResultsText(const GameResults& results, std::ostream& out, char separator = '\t');
+
+/// @brief Версия двоичного формата результатов.
+const std::uint32_t RESULTS_FORMAT_VERSION = 2;
+
+/**
+ * @brief Записывает результаты в двоичном столбцовом формате, который можно
+ * отобразить в память.
+ * @details Формат (little-endian): заголовок из 32 байт —
+ * `"UNOR"`, версия (uint32), число игроков (uint32), 4 резервных байта,
+ * число игр N (uint64), 8 резервных байт; затем столбцы по порядку:
+ * победители (int16 × N), партии (uint16 × N), ходы (uint32 × N) и очки
+ * каждого игрока (int16 × N). Каждый столбец начинается со смещения,
+ * кратного 8; промежутки заполнены нулями. Блоки столбцов пишутся
+ * напрямую, без копирования.
+*/
+void exportResultsBinary(const GameResults& results, std::ostream& out);
@@ -0,0 +1,71 @@
+#include "game_results.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+/// @brief Ограничивает значение диапазоном типа T.
+template<class T>
+static T pack(long long value)
+{
+    return static_cast<T>(std::max<long long>(
+        std::numeric_limits<T>::min(),
+        std::min<long long>(std::numeric_limits<T>::max(), value)));
+}
+
+GameResults::GameResults(int players):
+    players_(players), winners(), scores(), sets(), turns()
+{
+    if (players > std::numeric_limits<std::int16_t>::max())
+        throw std::invalid_argument("Too many players for game results");
+    scores.resize(players);
+}
+
+void GameResults::reserve(size_t games)
+{
+    winners.reserve(games);
+    for (auto& column : scores) column.reserve(games);
+    sets.reserve(games);
+    turns.reserve(games);
+}
+
+void GameResults::add(int winner, const int *gameScores, int setsPlayed, unsigned turnsPlayed)
+{
+    winners.push_back(static_cast<std::int16_t>(winner));
+    for (int i = 0; i < players_; ++i)
+        scores[i].push_back(pack<std::int16_t>(gameScores[i]));
+    sets.push_back(pack<std::uint16_t>(setsPlayed));
+    turns.push_back(turnsPlayed);
+}
+
+void GameResults::add(const UnoGame &game, int winner, unsigned turnsPlayed)
+{
+    if (game.numberOfPlayers() != players_)
+        throw std::invalid_argument("Number of players does not match");
+    winners.push_back(static_cast<std::int16_t>(winner));
+    for (int i = 0; i < players_; ++i)
+        scores[i].push_back(pack<std::int16_t>(game.scoreOf(i)));
+    sets.push_back(pack<std::uint16_t>(game.currentSetNumber()));
+    turns.push_back(turnsPlayed);
+}
+
+void GameResults::append(const GameResults &other)
+{
+    if (other.players_ != players_)
+        throw std::invalid_argument("Number of players does not match");
+    for (size_t g = 0; g < other.size(); ++g)
+    {
+        winners.push_back(other.winners[g]);
+        for (int i = 0; i < players_; ++i) scores[i].push_back(other.scores[i][g]);
+        sets.push_back(other.sets[g]);
+        turns.push_back(other.turns[g]);
+    }
+}
+
+void GameResults::clear()
+{
+    winners.clear();
+    for (auto& column : scores) column.clear();
+    sets.clear();
+    turns.clear();
+}
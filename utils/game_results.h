@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../game/uno_game.h"
+
+/**
+ * @brief Растущий столбец значений, хранящийся блоками по `CHUNK_SIZE`
+ * элементов.
+ * @details При росте элементы не копируются, а блоки можно отдавать
+ * потребителям (запись в файл, статистика) напрямую, без копирования.
+*/
+template<class T>
+class ChunkedColumn
+{
+public:
+    static constexpr size_t CHUNK_SIZE = size_t(1) << 16;
+
+private:
+    std::vector<std::unique_ptr<T[]>> chunks;
+    size_t size_ = 0;
+
+public:
+    size_t size() const { return size_; }
+
+    void push_back(T value)
+    {
+        if (size_ / CHUNK_SIZE == chunks.size())
+            chunks.emplace_back(new T[CHUNK_SIZE]);
+        chunks[size_ / CHUNK_SIZE][size_ % CHUNK_SIZE] = value;
+        ++size_;
+    }
+
+    T operator[](size_t i) const { return chunks[i / CHUNK_SIZE][i % CHUNK_SIZE]; }
+
+    /// @return число заполненных (полностью или частично) блоков.
+    size_t chunkCount() const { return (size_ + CHUNK_SIZE - 1) / CHUNK_SIZE; }
+    /// @return начало блока `k`.
+    const T * chunk(size_t k) const { return chunks[k].get(); }
+    /// @return число элементов в блоке `k`.
+    size_t chunkLength(size_t k) const
+        { return k + 1 < chunkCount() ? CHUNK_SIZE : size_ - k * CHUNK_SIZE; }
+
+    /// @brief Выделяет блоки под `n` элементов.
+    void reserve(size_t n)
+    {
+        while (chunks.size() * CHUNK_SIZE < n) chunks.emplace_back(new T[CHUNK_SIZE]);
+    }
+
+    /// @brief Очищает столбец, оставляя блоки для повторного использования.
+    void clear() { size_ = 0; }
+};
+
+/**
+ * @brief Компактные результаты игр в виде столбцов: номер победителя, очки
+ * каждого игрока, число партий и ходов.
+ * @details Победитель хранится двумя байтами (−1 — победителя нет), очки —
+ * двумя байтами на игрока, число партий — двумя, число ходов — четырьмя
+ * байтами, то есть 8 + 2·игроков байт на игру. Столбцы хранятся блоками
+ * ( @see ChunkedColumn ).
+*/
+class GameResults
+{
+    int players_;
+    ChunkedColumn<std::int16_t> winners;
+    /// @brief scores[i][g] — очки игрока `i` в игре `g`
+    std::vector<ChunkedColumn<std::int16_t>> scores;
+    ChunkedColumn<std::uint16_t> sets;
+    ChunkedColumn<std::uint32_t> turns;
+
+public:
+    /// @throws std::invalid_argument, если номер игрока не помещается в
+    /// столбец победителей.
+    explicit GameResults(int players = 0);
+
+    int players() const { return players_; }
+    size_t size() const { return winners.size(); }
+
+    void reserve(size_t games);
+    /// @brief Добавляет игру с победителем `winner`, очками `gameScores[i]`,
+    /// `setsPlayed` партиями и `turnsPlayed` ходами.
+    void add(int winner, const int * gameScores, int setsPlayed = 0, unsigned turnsPlayed = 0);
+    /// @brief Добавляет результат только что законченной игры `game`.
+    void add(const UnoGame& game, int winner, unsigned turnsPlayed = 0);
+    /// @brief Дописывает результаты с тем же числом игроков.
+    /// @throws std::invalid_argument если число игроков различается.
+    void append(const GameResults& other);
+
+    int winner(size_t game) const { return winners[game]; }
+    int score(size_t game, int player) const { return scores[player][game]; }
+    int setsOf(size_t game) const { return sets[game]; }
+    unsigned turnsOf(size_t game) const { return turns[game]; }
+
+    /// @brief Столбцы для экспорта без копирования.
+    const ChunkedColumn<std::int16_t>& winnersColumn() const { return winners; }
+    const ChunkedColumn<std::int16_t>& scoresColumn(int player) const { return scores[player]; }
+    const ChunkedColumn<std::uint16_t>& setsColumn() const { return sets; }
+    const ChunkedColumn<std::uint32_t>& turnsColumn() const { return turns; }
+
+    void clear();
+};
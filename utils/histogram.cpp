@@ -0,0 +1,90 @@
+#include "histogram.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+/// @return номер старшего единичного бита `value` > 0.
+static int highestBit(std::uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+#endif
+}
+
+LogLinearHistogram::LogLinearHistogram(int precision, int maxBits):
+    precision(precision), maxBits(maxBits), counts(),
+    total(0), minimum(std::numeric_limits<std::uint64_t>::max()), maximum(0), sum(0)
+{
+    if (precision < 1 || precision > 16 || maxBits < precision || maxBits > 64)
+        throw std::invalid_argument("Invalid histogram parameters");
+    // 2^precision точных значений и по 2^(precision − 1) корзин на каждый
+    // следующий разряд
+    const size_t exact = size_t(1) << precision;
+    counts.assign(exact + (maxBits - precision) * (exact / 2), 0);
+}
+
+size_t LogLinearHistogram::indexOf(std::uint64_t value) const
+{
+    const std::uint64_t exact = std::uint64_t(1) << precision;
+    if (value < exact) return static_cast<size_t>(value);
+    // shift ≥ 1: value >> shift лежит в [exact / 2; exact)
+    const int shift = highestBit(value) - precision + 1;
+    const size_t index = exact + (shift - 1) * (exact / 2)
+        + static_cast<size_t>((value >> shift) - exact / 2);
+    return std::min(index, counts.size() - 1);
+}
+
+std::uint64_t LogLinearHistogram::lowestOf(size_t index) const
+{
+    const size_t exact = size_t(1) << precision;
+    if (index < exact) return index;
+    const size_t shift = (index - exact) / (exact / 2) + 1;
+    const std::uint64_t mantissa = (index - exact) % (exact / 2) + exact / 2;
+    return mantissa << shift;
+}
+
+void LogLinearHistogram::merge(const LogLinearHistogram &other)
+{
+    if (other.precision != precision || other.maxBits != maxBits)
+        throw std::invalid_argument("Cannot merge histograms with different parameters");
+    for (size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+    total += other.total;
+    sum += other.sum;
+    minimum = std::min(minimum, other.minimum);
+    maximum = std::max(maximum, other.maximum);
+}
+
+void LogLinearHistogram::clear()
+{
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    sum = 0;
+    minimum = std::numeric_limits<std::uint64_t>::max();
+    maximum = 0;
+}
+
+std::uint64_t LogLinearHistogram::percentile(double q) const
+{
+    if (total == 0) return 0;
+    const double rank = std::max(1.0, q * total);
+    std::uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+            return std::min(std::max(lowestOf(i), min()), maximum);
+    }
+    return maximum;
+}
+
+std::uint64_t LogLinearHistogram::countAtLeast(std::uint64_t value) const
+{
+    std::uint64_t result = 0;
+    for (size_t i = indexOf(value); i < counts.size(); ++i) result += counts[i];
+    return result;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Лог-линейная гистограмма (в стиле HDR Histogram) неотрицательных
+ * целых значений с фиксированной памятью.
+ * @details Значения меньше 2^precision хранятся точно, большие — в
+ * корзинах, ширина которых растет вдвое с каждой степенью двойки, так что
+ * относительная погрешность не превышает 2^(1 − precision). Значения больше
+ * 2^maxBits − 1 учитываются в последней корзине. Гистограммы с одинаковыми
+ * параметрами объединяются методом `merge`.
+*/
+class LogLinearHistogram
+{
+    int precision, maxBits;
+    std::vector<std::uint64_t> counts;
+    std::uint64_t total, minimum, maximum;
+    double sum;
+
+    size_t indexOf(std::uint64_t value) const;
+    /// @return наименьшее значение корзины `index`.
+    std::uint64_t lowestOf(size_t index) const;
+
+public:
+    /// @param precision число точных двоичных разрядов, от 1 до 16.
+    /// @param maxBits разрядность наибольшего учитываемого значения, до 64.
+    /// @throws std::invalid_argument если параметры некорректны.
+    explicit LogLinearHistogram(int precision = 7, int maxBits = 32);
+
+    void record(std::uint64_t value, std::uint64_t count = 1)
+    {
+        counts[indexOf(value)] += count;
+        total += count;
+        sum += static_cast<double>(value) * count;
+        if (value < minimum) minimum = value;
+        if (value > maximum) maximum = value;
+    }
+
+    /// @throws std::invalid_argument если параметры гистограмм различаются.
+    void merge(const LogLinearHistogram& other);
+    void clear();
+
+    std::uint64_t count() const { return total; }
+    /// @return наименьшее значение или 0, если значений нет.
+    std::uint64_t min() const { return total == 0 ? 0 : minimum; }
+    std::uint64_t max() const { return maximum; }
+    double mean() const { return total == 0 ? 0 : sum / total; }
+    /// @return значение, не меньше которого `q`-я доля значений (с
+    /// точностью гистограммы), `q` из [0; 1].
+    std::uint64_t percentile(double q) const;
+    /// @return число значений, не меньших `value` (с точностью гистограммы).
+    std::uint64_t countAtLeast(std::uint64_t value) const;
+};
@@ -154,3 +154,16 @@ void Logger::handleMessageOverflow()
 {
     out << "Message queue overflew." << std::endl;
 }
+
+void Logger::handleHandsSwapped(int firstPlayer, int secondPlayer)
+{
+    printPlayer(firstPlayer);
+    out << "swapped hands with Player #" << secondPlayer << "." << std::endl;
+}
+
+void Logger::handleHandsRotated(GameDirection direction)
+{
+    out << "Hands were passed in '"
+        << (direction == GameDirection::Direct ? "direct" : "inverse")
+        << "' direction." << std::endl;
+}
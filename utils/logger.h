@@ -32,4 +32,6 @@ public:
     virtual void handlePlayerWonGame(int playerIndex, int totalScore);
     virtual void handleDirectionChanged(GameDirection newDirection);
     virtual void handleMessageOverflow();
+    virtual void handleHandsSwapped(int firstPlayer, int secondPlayer);
+    virtual void handleHandsRotated(GameDirection direction);
 };
\ No newline at end of file
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @return `threads`, если это число положительно, иначе число ядер.
+inline int resolveThreads(int threads)
+{
+    if (threads > 0) return threads;
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+/**
+ * @brief Вызывает `body(thread, i)` для всех `i` из [0; count) в `threads`
+ * потоках.
+ * @param chunk сколько индексов поток забирает за раз.
+ * @details Номер потока `thread` лежит в [0; threads), по нему тело может
+ * обращаться к данным своего потока без синхронизации. Если тело выбросило
+ * исключение, остальные потоки заканчивают текущую порцию и останавливаются,
+ * а первое исключение выбрасывается из parallelFor.
+*/
+template<class F>
+void parallelFor(std::uint64_t count, int threads, std::uint64_t chunk, F body)
+{
+    threads = resolveThreads(threads);
+    chunk = std::max<std::uint64_t>(chunk, 1);
+    std::atomic<std::uint64_t> next(0);
+    std::atomic<bool> stop(false);
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto work = [&](int thread) {
+        try
+        {
+            while (!stop)
+            {
+                const std::uint64_t begin = next.fetch_add(chunk);
+                if (begin >= count) break;
+                const std::uint64_t end = std::min(count, begin + chunk);
+                for (std::uint64_t i = begin; i < end; ++i) body(thread, i);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+            stop = true;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work, t);
+    work(0);
+    for (std::thread& thread : pool) thread.join();
+    if (error) std::rethrow_exception(error);
+}
+
+/**
+ * @brief Вызывает `body(thread, i)` для всех `i` из [0; count) в `threads`
+ * потоках с перехватом работы.
+ * @details В отличие от parallelFor, подходит для задач очень разной
+ * длительности, у которых важна локальность: каждый поток сначала получает
+ * свой непрерывный отрезок индексов и проходит его по порядку, а закончив,
+ * забирает вторую половину отрезка у самого загруженного потока. Исключения
+ * обрабатываются так же, как в parallelFor.
+*/
+template<class F>
+void parallelForStealing(std::uint64_t count, int threads, F body)
+{
+    threads = resolveThreads(threads);
+    if (static_cast<std::uint64_t>(threads) > count)
+        threads = static_cast<int>(std::max<std::uint64_t>(count, 1));
+
+    // Оставшийся отрезок потока [begin; end)
+    struct Range
+    {
+        std::mutex mutex;
+        std::uint64_t begin = 0, end = 0;
+    };
+    std::vector<Range> ranges(threads);
+    for (int t = 0; t < threads; ++t)
+    {
+        ranges[t].begin = count * t / threads;
+        ranges[t].end = count * (t + 1) / threads;
+    }
+    std::atomic<bool> stop(false);
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    // Перехват: у потока с самым длинным отрезком забирается его вторая половина
+    auto steal = [&](int thread) {
+        for (;;)
+        {
+            int victim = -1;
+            std::uint64_t longest = 0;
+            for (int t = 0; t < threads; ++t)
+            {
+                if (t == thread) continue;
+                std::lock_guard<std::mutex> lock(ranges[t].mutex);
+                const std::uint64_t length = ranges[t].end - ranges[t].begin;
+                if (length > longest) { longest = length; victim = t; }
+            }
+            if (victim < 0) return false;
+            std::lock(ranges[thread].mutex, ranges[victim].mutex);
+            std::lock_guard<std::mutex> own(ranges[thread].mutex, std::adopt_lock);
+            std::lock_guard<std::mutex> other(ranges[victim].mutex, std::adopt_lock);
+            Range& from = ranges[victim];
+            const std::uint64_t length = from.end - from.begin;
+            // Отрезок мог уменьшиться, пока не был заблокирован
+            if (length == 0) continue;
+            const std::uint64_t middle = from.end - (length + 1) / 2;
+            ranges[thread].begin = middle;
+            ranges[thread].end = from.end;
+            from.end = middle;
+            return true;
+        }
+    };
+
+    auto work = [&](int thread) {
+        try
+        {
+            Range& own = ranges[thread];
+            while (!stop)
+            {
+                std::uint64_t i;
+                {
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    if (own.begin < own.end) i = own.begin++;
+                    else i = count;
+                }
+                if (i == count)
+                {
+                    if (!steal(thread)) break;
+                    continue;
+                }
+                body(thread, i);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+            stop = true;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work, t);
+    work(0);
+    for (std::thread& thread : pool) thread.join();
+    if (error) std::rethrow_exception(error);
+}
@@ -0,0 +1,231 @@
+#include "policy.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+/// @brief y = x · W + b для пакета из `batch` строк.
+/// @details Внутренний цикл идет по непрерывным строкам транспонированной
+/// матрицы `weightsT` и выхода, поэтому компилятор векторизует его.
+static void denseForward(
+    const float * x, int batch, int in,
+    const float * weightsT, const float * bias, int out,
+    float * y)
+{
+    for (int b = 0; b < batch; ++b)
+    {
+        float * row = y + static_cast<size_t>(b) * out;
+        const float * input = x + static_cast<size_t>(b) * in;
+        std::copy(bias, bias + out, row);
+        for (int i = 0; i < in; ++i)
+        {
+            const float value = input[i];
+            if (value == 0) continue;
+            const float * w = weightsT + static_cast<size_t>(i) * out;
+            for (int o = 0; o < out; ++o)
+                row[o] += value * w[o];
+        }
+    }
+}
+
+void MlpPolicy::addLayer(
+    int in, int out,
+    const std::vector<float>& weights,
+    const std::vector<float>& bias)
+{
+    if (in <= 0 || out <= 0)
+        throw std::invalid_argument("Invalid layer size");
+    if (!layers.empty() && layers.back().out != in)
+        throw std::invalid_argument("Layer input does not match previous layer");
+    if (weights.size() != static_cast<size_t>(in) * out 
+        || bias.size() != static_cast<size_t>(out))
+        throw std::invalid_argument("Invalid number of layer weights");
+
+    Layer layer{ in, out, std::vector<float>(weights.size()), bias };
+    for (int o = 0; o < out; ++o)
+        for (int i = 0; i < in; ++i)
+            layer.weights[static_cast<size_t>(i) * out + o] =
+                weights[static_cast<size_t>(o) * in + i];
+    layers.push_back(std::move(layer));
+}
+
+int MlpPolicy::inputSize() const
+{
+    return layers.empty() ? 0 : layers.front().in;
+}
+
+int MlpPolicy::outputSize() const
+{
+    return layers.empty() ? 0 : layers.back().out;
+}
+
+void MlpPolicy::forward(const float *inputs, int batchSize, float *outputs) const
+{
+    if (layers.empty()) return;
+    std::vector<float> current, next;
+    const float * x = inputs;
+    for (size_t l = 0; l < layers.size(); ++l)
+    {
+        const Layer& layer = layers[l];
+        const bool last = l + 1 == layers.size();
+        float * y = outputs;
+        if (!last)
+        {
+            next.resize(static_cast<size_t>(batchSize) * layer.out);
+            y = next.data();
+        }
+        denseForward(x, batchSize, layer.in,
+            layer.weights.data(), layer.bias.data(), layer.out, y);
+        if (last) break;
+        for (float& v : next) v = std::max(v, 0.f);
+        std::swap(current, next);
+        x = current.data();
+    }
+}
+
+/// @brief Читает веса и смещения слоя размера `inputs × outputs` и добавляет
+/// слой в политику.
+static void readLayer(std::istream& in, int inputs, int outputs, MlpPolicy& policy)
+{
+    std::vector<float> weights(static_cast<size_t>(inputs) * outputs);
+    std::vector<float> bias(outputs);
+    for (float& w : weights) in >> w;
+    for (float& b : bias) in >> b;
+    if (!in) throw std::runtime_error("Unexpected end of policy weights");
+    policy.addLayer(inputs, outputs, weights, bias);
+}
+
+std::unique_ptr<PolicyModel> loadPolicy(std::istream &in)
+{
+    std::string kind;
+    in >> kind;
+    std::unique_ptr<MlpPolicy> policy(new MlpPolicy());
+    try
+    {
+        if (kind == "linear")
+        {
+            int inputs = 0, outputs = 0;
+            in >> inputs >> outputs;
+            if (!in) throw std::runtime_error("Invalid linear policy header");
+            readLayer(in, inputs, outputs, *policy);
+        }
+        else if (kind == "mlp")
+        {
+            int numberOfLayers = 0;
+            in >> numberOfLayers;
+            if (!in || numberOfLayers <= 0)
+                throw std::runtime_error("Invalid mlp policy header");
+            for (int l = 0; l < numberOfLayers; ++l)
+            {
+                int inputs = 0, outputs = 0;
+                in >> inputs >> outputs;
+                if (!in) throw std::runtime_error("Invalid mlp layer header");
+                readLayer(in, inputs, outputs, *policy);
+            }
+        }
+        else throw std::runtime_error("Unknown policy type '" + kind + "'");
+    }
+    catch (const std::invalid_argument& e)
+    {
+        throw std::runtime_error(e.what());
+    }
+    return policy;
+}
+
+BatchEvaluator::Session::Session(BatchEvaluator &evaluator):
+    evaluator(evaluator)
+{
+    std::lock_guard<std::mutex> lock(evaluator.mutex);
+    ++evaluator.clients;
+}
+
+BatchEvaluator::Session::~Session()
+{
+    std::lock_guard<std::mutex> lock(evaluator.mutex);
+    --evaluator.clients;
+    // Остальные клиенты могли ждать именно этот поток
+    evaluator.done.notify_all();
+}
+
+BatchEvaluator::BatchEvaluator(
+    const PolicyModel &model,
+    int maxBatchSize,
+    std::chrono::microseconds maxWait):
+    model(model),
+    maxBatchSize(std::max(maxBatchSize, 1)),
+    maxWait(maxWait),
+    pending(),
+    clients(0),
+    running(false)
+{
+    pending.reserve(this->maxBatchSize);
+}
+
+int BatchEvaluator::evaluate(const float *features, const std::uint8_t *mask)
+{
+    Request request{ features, mask, -1, false, nullptr };
+    std::unique_lock<std::mutex> lock(mutex);
+    pending.push_back(&request);
+    while (!request.done)
+    {
+        const bool full = pending.size() >= static_cast<size_t>(maxBatchSize)
+            || pending.size() >= static_cast<size_t>(std::max(clients, 1));
+        if (!running && full)
+        {
+            runBatch(lock);
+            continue;
+        }
+        bool timeout = done.wait_for(lock, maxWait) == std::cv_status::timeout;
+        if (timeout && !running && !request.done) runBatch(lock);
+    }
+    if (request.error) std::rethrow_exception(request.error);
+    return request.action;
+}
+
+void BatchEvaluator::runBatch(std::unique_lock<std::mutex>& lock)
+{
+    running = true;
+    batch.swap(pending);
+    pending.clear();
+    lock.unlock();
+
+    // Ошибка модели достается всем запросам пакета: иначе их потоки ждали
+    // бы вечно, а вычислитель остался бы занятым
+    std::exception_ptr error;
+    try
+    {
+        const int in = model.inputSize(), out = model.outputSize();
+        const int size = static_cast<int>(batch.size());
+        inputs.resize(static_cast<size_t>(size) * in);
+        outputs.resize(static_cast<size_t>(size) * out);
+        for (int b = 0; b < size; ++b)
+            std::copy(batch[b]->features, batch[b]->features + in,
+                inputs.begin() + static_cast<size_t>(b) * in);
+
+        model.forward(inputs.data(), size, outputs.data());
+
+        for (int b = 0; b < size; ++b)
+        {
+            const float * scores = outputs.data() + static_cast<size_t>(b) * out;
+            int best = -1;
+            for (int a = 0; a < out; ++a)
+                if (batch[b]->mask[a] && (best < 0 || scores[a] > scores[best]))
+                    best = a;
+            batch[b]->action = best;
+        }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    lock.lock();
+    for (Request * request : batch) 
+    {
+        request->error = error;
+        request->done = true;
+    }
+    batch.clear();
+    running = false;
+    done.notify_all();
+}
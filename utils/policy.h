@@ -0,0 +1,166 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Модель политики: отображает пакет векторов признаков в пакет
+ * оценок действий.
+*/
+class PolicyModel
+{
+public:
+    virtual ~PolicyModel() {}
+
+    /// @return размер входного вектора.
+    virtual int inputSize() const = 0;
+    /// @return количество оценок на выходе.
+    virtual int outputSize() const = 0;
+
+    /// @brief Вычисляет оценки действий для пакета входов.
+    /// @param inputs матрица `batchSize × inputSize()` по строкам.
+    /// @param batchSize размер пакета.
+    /// @param outputs матрица `batchSize × outputSize()` по строкам.
+    virtual void forward(
+        const float * inputs, int batchSize, float * outputs) const = 0;
+};
+
+/**
+ * @brief Многослойный перцептрон с активацией ReLU между слоями. Линейная
+ * политика — перцептрон с одним слоем.
+ *
+ * @details Веса слоя хранятся транспонированными (`in × out`), чтобы
+ * внутренний цикл по выходам шел по непрерывной памяти и векторизовался
+ * компилятором для всего пакета сразу.
+*/
+class MlpPolicy: public PolicyModel
+{
+    struct Layer
+    {
+        int in, out;
+        /// @brief Транспонированная матрица весов, `in × out`.
+        std::vector<float> weights;
+        std::vector<float> bias;
+    };
+
+    std::vector<Layer> layers;
+
+public:
+    /// @brief Добавляет полносвязный слой.
+    /// @param in размер входа, должен совпадать с выходом предыдущего слоя.
+    /// @param out размер выхода.
+    /// @param weights матрица `out × in` по строкам.
+    /// @param bias вектор размера `out`.
+    /// @throws std::invalid_argument при несовпадении размеров.
+    void addLayer(
+        int in, int out,
+        const std::vector<float>& weights,
+        const std::vector<float>& bias);
+
+    int inputSize() const override;
+    int outputSize() const override;
+    void forward(
+        const float * inputs, int batchSize, float * outputs) const override;
+};
+
+/**
+ * @brief Загружает политику из текстового файла весов.
+ * @details Формат файла (числа разделяются пробельными символами):
+ *
+ *     linear <in> <out>
+ *     <матрица весов out × in по строкам> <смещения, out чисел>
+ *
+ * или
+ *
+ *     mlp <число слоев>
+ *     <in> <out> <матрица весов out × in> <смещения> — для каждого слоя
+ *
+ * @throws std::runtime_error если файл имеет неверный формат.
+*/
+std::unique_ptr<PolicyModel> loadPolicy(std::istream& in);
+
+/**
+ * @brief Пакетный вычислитель политики, общий для многих одновременно
+ * идущих игр.
+ *
+ * @details Каждая игра (поток) вызывает `evaluate` и блокируется, пока ее
+ * запрос не будет вычислен. Пакет вычисляется, когда запросы прислали все
+ * подключенные клиенты, когда набрано `maxBatchSize` запросов или когда
+ * истекло время ожидания `maxWait`. Пакет вычисляет один из ожидающих
+ * потоков, отдельного потока вычислителю не нужно.
+ *
+ * Клиент — это поток, в котором проводятся игры; он регистрируется объектом
+ * `Session` на время своей работы. Без зарегистрированных клиентов каждый
+ * запрос вычисляется сразу, так что вычислитель можно использовать и в
+ * однопоточных играх.
+*/
+class BatchEvaluator
+{
+    struct Request
+    {
+        const float * features;
+        const std::uint8_t * mask;
+        int action;
+        bool done;
+        /// @brief Ошибка вычисления пакета, в котором был запрос.
+        std::exception_ptr error;
+    };
+
+    const PolicyModel& model;
+    const int maxBatchSize;
+    const std::chrono::microseconds maxWait;
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::vector<Request *> pending;
+    int clients;
+    bool running;
+
+    /// @brief Буферы пакета, используются только вычисляющим потоком.
+    std::vector<Request *> batch;
+    std::vector<float> inputs;
+    std::vector<float> outputs;
+
+    /// @brief Вычисляет все ожидающие запросы. Вызывается с захваченным
+    /// `lock`, на время вычисления мьютекс отпускается.
+    void runBatch(std::unique_lock<std::mutex>& lock);
+
+public:
+    /// @brief Регистрация потока-клиента на время жизни объекта.
+    class Session
+    {
+        BatchEvaluator& evaluator;
+    public:
+        explicit Session(BatchEvaluator& evaluator);
+        ~Session();
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+    };
+
+    /// @param model модель, вход которой — вектор признаков (см. FeatureLayout),
+    /// а выход — оценки действий (см. ActionSpace).
+    /// @param maxBatchSize максимальный размер пакета.
+    /// @param maxWait сколько ждать остальных клиентов, прежде чем вычислить
+    /// неполный пакет.
+    BatchEvaluator(
+        const PolicyModel& model,
+        int maxBatchSize = 64,
+        std::chrono::microseconds maxWait = std::chrono::microseconds(200));
+
+    /// @brief Выбирает действие с наибольшей оценкой среди допустимых.
+    /// @param features вектор признаков размера `model.inputSize()`.
+    /// @param mask маска допустимых действий размера `model.outputSize()`.
+    /// @return номер действия или -1, если допустимых действий нет.
+    /// @throws исключение модели, если вычисление пакета с этим запросом
+    /// завершилось ошибкой; вычислитель при этом остается работоспособным.
+    int evaluate(const float * features, const std::uint8_t * mask);
+
+    /// @return модель, которую вычисляет вычислитель.
+    const PolicyModel& policy() const { return model; }
+};
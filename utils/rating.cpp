@@ -0,0 +1,342 @@
+#include "rating.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+void RatingResults::add(const std::vector<int> &ids, const std::vector<int> &places)
+{
+    if (ids.size() != places.size())
+        throw std::invalid_argument("Every participant must have a place");
+    for (int place : places)
+        if (place < 0 || place > std::numeric_limits<std::uint16_t>::max())
+            throw std::invalid_argument("Place is out of range");
+    for (size_t k = 0; k < ids.size(); ++k)
+    {
+        this->ids.push_back(ids[k]);
+        ranks.push_back(static_cast<std::uint16_t>(places[k]));
+    }
+    offsets.push_back(static_cast<std::uint32_t>(this->ids.size()));
+}
+
+void RatingResults::clear()
+{
+    offsets.assign(1, 0);
+    ids.clear();
+    ranks.clear();
+}
+
+RatingTable::RatingTable(const RatingParams &params, RatingResults *log):
+    params(params), log(log)
+{}
+
+int RatingTable::idLocked(const std::string &name)
+{
+    auto entry = index.find(name);
+    if (entry != index.end()) return entry->second;
+    const int id = static_cast<int>(names.size());
+    index.emplace(name, id);
+    names.push_back(name);
+    mu.push_back(params.mu);
+    sigma.push_back(params.sigma);
+    games.push_back(0);
+    return id;
+}
+
+int RatingTable::id(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return idLocked(name);
+}
+
+void RatingTable::record(const std::vector<int> &ids, const std::vector<int> &places)
+{
+    if (ids.size() != places.size())
+        throw std::invalid_argument("Every participant must have a place");
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int id : ids)
+        if (id < 0 || id >= static_cast<int>(names.size()))
+            throw std::invalid_argument("Unknown participant");
+    if (log != nullptr) log->add(ids, places);
+    updateLocked(ids, places);
+}
+
+void RatingTable::updateLocked(const std::vector<int> &ids, const std::vector<int> &places)
+{
+    const size_t n = ids.size();
+    if (n < 2) return;
+    strength.resize(n);
+    sums.resize(n);
+    delta.resize(n);
+    omega.resize(n);
+    tied.resize(n);
+
+    // Обновление Вэна — Линя для модели Плакетта — Льюса
+    double c2 = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double s = sigma[ids[i]];
+        sigma[ids[i]] = std::sqrt(s * s + params.tau * params.tau);
+        c2 += sigma[ids[i]] * sigma[ids[i]] + params.beta * params.beta;
+    }
+    const double c = std::sqrt(c2);
+    for (size_t i = 0; i < n; ++i) strength[i] = std::exp(mu[ids[i]] / c);
+    // sums[q] — сумма сил участников, занявших место не выше q; tied[q] — число
+    // участников на месте q
+    for (size_t q = 0; q < n; ++q)
+    {
+        sums[q] = 0;
+        tied[q] = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (places[i] >= places[q]) sums[q] += strength[i];
+            if (places[i] == places[q]) ++tied[q];
+        }
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        omega[i] = delta[i] = 0;
+        for (size_t q = 0; q < n; ++q)
+        {
+            if (places[q] > places[i]) continue;
+            const double quotient = strength[i] / sums[q];
+            omega[i] += ((q == i ? 1 : 0) - quotient) / tied[q];
+            delta[i] += quotient * (1 - quotient) / tied[q];
+        }
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        const int id = ids[i];
+        const double variance = sigma[id] * sigma[id];
+        const double gamma = sigma[id] / c;
+        mu[id] += variance / c * omega[i];
+        sigma[id] = std::sqrt(variance
+            * std::max(1 - variance / c2 * gamma * delta[i], 1e-4));
+        ++games[id];
+    }
+}
+
+void RatingTable::refit(const RatingResults &results, int iterations)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const size_t m = names.size();
+    // Сила γ хранится логарифмом, чтобы не переполняться
+    std::vector<double> logGamma(m, 0), wins(m, 0), denominator(m), information(m);
+    std::vector<std::uint64_t> played(m, 0);
+    std::vector<int> order;
+
+    // Выборы победителя: участник на позиции s выбирается среди позиций s..k-1
+    auto forEachChoice = [&](auto visit) {
+        for (size_t r = 0; r < results.size(); ++r)
+        {
+            const int k = results.participants(r);
+            order.resize(k);
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](int a, int b) {
+                return results.place(r, a) < results.place(r, b);
+            });
+            for (int s = 0; s + 1 < k; ++s)
+            {
+                // Выбор среди равных мест не определен
+                if (results.place(r, order[s]) == results.place(r, order[s + 1])) continue;
+                visit(r, order, s, k);
+            }
+        }
+    };
+
+    for (size_t r = 0; r < results.size(); ++r)
+        for (int k = 0; k < results.participants(r); ++k)
+            ++played[results.id(r, k)];
+    forEachChoice([&](size_t r, const std::vector<int>& order, int s, int k) {
+        wins[results.id(r, order[s])] += 1;
+    });
+
+    for (int iteration = 0; iteration < iterations; ++iteration)
+    {
+        std::fill(denominator.begin(), denominator.end(), 0);
+        forEachChoice([&](size_t r, const std::vector<int>& order, int s, int k) {
+            double sum = 0;
+            for (int t = s; t < k; ++t) sum += std::exp(logGamma[results.id(r, order[t])]);
+            for (int t = s; t < k; ++t) denominator[results.id(r, order[t])] += 1 / sum;
+        });
+        for (size_t i = 0; i < m; ++i)
+            if (wins[i] > 0 && denominator[i] > 0)
+                logGamma[i] = std::log(wins[i] / denominator[i]);
+        // Нормировка: среднее ln γ участников с победами равно нулю
+        double total = 0;
+        int counted = 0;
+        for (size_t i = 0; i < m; ++i)
+            if (wins[i] > 0) total += logGamma[i], ++counted;
+        if (counted == 0) break;
+        for (size_t i = 0; i < m; ++i)
+            if (wins[i] > 0) logGamma[i] -= total / counted;
+    }
+
+    double weakest = 0;
+    bool anyWins = false;
+    for (size_t i = 0; i < m; ++i)
+        if (wins[i] > 0) weakest = anyWins ? std::min(weakest, logGamma[i]) : logGamma[i],
+            anyWins = true;
+    for (size_t i = 0; i < m; ++i)
+        if (wins[i] == 0) logGamma[i] = weakest;
+
+    // Информация Фишера по ln γ: сумма p(1 − p) по выборам с участием игрока
+    std::fill(information.begin(), information.end(), 0);
+    forEachChoice([&](size_t r, const std::vector<int>& order, int s, int k) {
+        double sum = 0;
+        for (int t = s; t < k; ++t) sum += std::exp(logGamma[results.id(r, order[t])]);
+        for (int t = s; t < k; ++t)
+        {
+            const double p = std::exp(logGamma[results.id(r, order[t])]) / sum;
+            information[results.id(r, order[t])] += p * (1 - p);
+        }
+    });
+
+    for (size_t i = 0; i < m; ++i)
+    {
+        mu[i] = params.mu + params.beta * logGamma[i];
+        sigma[i] = information[i] > 0
+            ? std::min(params.sigma, params.beta / std::sqrt(information[i]))
+            : params.sigma;
+        games[i] = played[i];
+    }
+}
+
+int RatingTable::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(names.size());
+}
+
+std::string RatingTable::name(int id) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return names.at(id);
+}
+
+double RatingTable::mean(int id) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return mu.at(id);
+}
+
+double RatingTable::deviation(int id) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return sigma.at(id);
+}
+
+std::uint64_t RatingTable::gamesOf(int id) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return games.at(id);
+}
+
+void RatingTable::printTSV(std::ostream &out) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<int> order(names.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return mu[a] - 3 * sigma[a] > mu[b] - 3 * sigma[b];
+    });
+    out << "Name\tMu\tSigma\tConservative\tGames\n";
+    for (int i : order)
+        out << names[i] << '\t' << mu[i] << '\t' << sigma[i] << '\t'
+            << mu[i] - 3 * sigma[i] << '\t' << games[i] << '\n';
+}
+
+void writeRatingResults(
+    std::ostream &out, const RatingResults &results, const RatingTable &table)
+{
+    const int n = table.size();
+    out << "names " << n << '\n';
+    for (int i = 0; i < n; ++i) out << table.name(i) << '\n';
+    for (size_t r = 0; r < results.size(); ++r)
+    {
+        const int k = results.participants(r);
+        out << k;
+        for (int t = 0; t < k; ++t)
+            out << ' ' << results.id(r, t) << ' ' << results.place(r, t);
+        out << '\n';
+    }
+}
+
+RatingResults readRatingResults(std::istream &in, RatingTable &table)
+{
+    std::string word;
+    int n;
+    if (!(in >> word >> n) || word != "names" || n < 0)
+        throw std::runtime_error("Invalid results header");
+    in.ignore(1);
+    // Номера в файле переводятся в номера таблицы
+    std::vector<int> ids(n);
+    for (int i = 0; i < n; ++i)
+    {
+        std::string name;
+        if (!std::getline(in, name)) throw std::runtime_error("Missing participant name");
+        ids[i] = table.id(name);
+    }
+
+    RatingResults results;
+    std::vector<int> participants, places;
+    int k;
+    while (in >> k)
+    {
+        participants.resize(k);
+        places.resize(k);
+        for (int t = 0; t < k; ++t)
+        {
+            int id;
+            if (!(in >> id >> places[t]) || id < 0 || id >= n || places[t] < 0
+                || places[t] > std::numeric_limits<std::uint16_t>::max())
+                throw std::runtime_error("Invalid result entry");
+            participants[t] = ids[id];
+        }
+        results.add(participants, places);
+    }
+    if (!in.eof()) throw std::runtime_error("Invalid result entry");
+    return results;
+}
+
+RatingObserver::RatingObserver(UnoGame *game, RatingTable *table, bool perSet):
+    game(game), table(table), perSet(perSet), ids(), places(), knownIds()
+{}
+
+void RatingObserver::refreshIds()
+{
+    const int n = game->numberOfPlayers();
+    ids.resize(n);
+    places.resize(n);
+    for (int i = 0; i < n; ++i)
+    {
+        const UnoPlayer * player = game->player(i);
+        auto known = knownIds.find(player);
+        if (known == knownIds.end())
+            known = knownIds.emplace(player, table->id(player->name())).first;
+        ids[i] = known->second;
+    }
+}
+
+void RatingObserver::handlePlayerWonSet(int playerIndex, int score)
+{
+    if (!perSet || playerIndex < 0) return;
+    for (size_t i = 0; i < places.size(); ++i) places[i] = static_cast<int>(i) == playerIndex ? 0 : 1;
+    table->record(ids, places);
+}
+
+void RatingObserver::recordGame(int winnerIndex)
+{
+    const int n = static_cast<int>(ids.size());
+    // Место — число игроков, стоящих выше; победитель всегда первый
+    for (int i = 0; i < n; ++i)
+    {
+        if (i == winnerIndex) { places[i] = 0; continue; }
+        places[i] = winnerIndex >= 0 ? 1 : 0;
+        for (int j = 0; j < n; ++j)
+            if (j != winnerIndex && game->scoreOf(j) > game->scoreOf(i)) ++places[i];
+    }
+    table->record(ids, places);
+}
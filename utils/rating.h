@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../game/uno_game.h"
+
+/**
+ * @brief Компактное хранилище результатов игр для пакетного пересчета
+ * рейтингов. Результат — участники и их места (0 — первое место, равные
+ * места — ничья между участниками).
+ * @details Все результаты хранятся в трех плоских массивах, так что
+ * миллионы результатов занимают единицы байт на участника.
+*/
+class RatingResults
+{
+    /// @brief offsets[r] — начало результата `r` в `ids` и `ranks`.
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> ids;
+    std::vector<std::uint16_t> ranks;
+
+public:
+    RatingResults(): offsets(1, 0) {}
+
+    /// @brief Добавляет результат: `ids[k]` занял место `places[k]`.
+    /// @throws std::invalid_argument если размеры различаются или место не
+    /// помещается в хранилище (меньше 0 или больше 65535).
+    void add(const std::vector<int>& ids, const std::vector<int>& places);
+
+    size_t size() const { return offsets.size() - 1; }
+    /// @return число участников результата `r`.
+    int participants(size_t r) const { return offsets[r + 1] - offsets[r]; }
+    /// @return номер `k`-того участника результата `r`.
+    int id(size_t r, int k) const { return ids[offsets[r] + k]; }
+    /// @return место `k`-того участника результата `r`.
+    int place(size_t r, int k) const { return ranks[offsets[r] + k]; }
+
+    void clear();
+};
+
+/// @brief Начальный рейтинг и параметры модели рейтингов.
+struct RatingParams
+{
+    double mu = 25;
+    double sigma = 25.0 / 3;
+    /// @brief Разброс результата при известных силах.
+    double beta = 25.0 / 6;
+    /// @brief Прирост неопределенности перед каждым результатом, чтобы
+    /// рейтинг мог следовать за изменением силы.
+    double tau = 25.0 / 300;
+};
+
+/**
+ * @brief Рейтинги участников многопользовательских игр «каждый за себя» с
+ * неопределенностью, по имени игрока.
+ *
+ * @details Каждый участник описывается нормальным распределением силы
+ * N(mu, sigma²). Результаты учитываются по одному байесовским приближением
+ * Вэна — Линя для модели Плакетта — Льюса, так что рейтинги сходятся по ходу
+ * игр. Метод `refit` заново оценивает силы по всем сохраненным результатам
+ * MM-алгоритмом Хантера. Методы, меняющие таблицу, потокобезопасны.
+*/
+class RatingTable
+{
+    RatingParams params;
+    std::unordered_map<std::string, int> index;
+    std::vector<std::string> names;
+    std::vector<double> mu, sigma;
+    std::vector<std::uint64_t> games;
+    /// @brief Если не nullptr, сюда сохраняются все учтенные результаты.
+    RatingResults * log;
+    mutable std::mutex mutex;
+
+    /// @brief буферы обновления, чтобы не выделять память на каждый результат
+    std::vector<double> strength, sums, delta, omega;
+    std::vector<int> tied;
+
+    int idLocked(const std::string& name);
+    void updateLocked(const std::vector<int>& ids, const std::vector<int>& places);
+
+public:
+    explicit RatingTable(const RatingParams& params = RatingParams(), RatingResults * log = nullptr);
+
+    /// @return номер участника `name`; новый участник получает начальный
+    /// рейтинг.
+    int id(const std::string& name);
+
+    /// @brief Учитывает результат игры: `ids[k]` занял место `places[k]`.
+    /// @throws std::invalid_argument если размеры различаются или номер
+    /// участника некорректен.
+    void record(const std::vector<int>& ids, const std::vector<int>& places);
+
+    /**
+     * @brief Заново оценивает силы всех участников по результатам `results`.
+     * @details Каждый результат разбирается на последовательные выборы
+     * победителя среди оставшихся участников (выборы среди равных мест
+     * пропускаются), и силы γ модели Плакетта — Льюса находятся
+     * MM-алгоритмом за `iterations` итераций. Затем mu = mu₀ + beta·ln γ
+     * (среднее ln γ равно нулю), а sigma — из информации Фишера. Участники
+     * без побед получают наименьшую из найденных сил.
+    */
+    void refit(const RatingResults& results, int iterations = 100);
+
+    int size() const;
+    std::string name(int id) const;
+    double mean(int id) const;
+    double deviation(int id) const;
+    std::uint64_t gamesOf(int id) const;
+    /// @return консервативная оценка mu − 3·sigma.
+    double conservative(int id) const { return mean(id) - 3 * deviation(id); }
+
+    /// @brief Печатает таблицу, упорядоченную по консервативной оценке, в
+    /// формате TSV.
+    void printTSV(std::ostream& out) const;
+};
+
+/// @brief Записывает результаты с именами участников: сначала строка
+/// `names N` и N имен по одному на строку, затем по строке на результат
+/// `k id place id place ...`.
+void writeRatingResults(
+    std::ostream& out, const RatingResults& results, const RatingTable& table);
+
+/// @brief Читает результаты, записанные writeRatingResults, регистрируя
+/// участников в `table` по именам.
+/// @throws std::runtime_error если формат нарушен.
+RatingResults readRatingResults(std::istream& in, RatingTable& table);
+
+/**
+ * @brief Наблюдатель, который передает в таблицу рейтингов результаты игр
+ * (победитель — первое место, остальные по убыванию очков) и, если
+ * `perSet`, результаты партий (победитель — первое место, остальные делят
+ * второе). Участники различаются по `UnoPlayer::name()`; имя каждого
+ * игрока читается один раз, так что игрок, который называет себя по-разному,
+ * остается одним участником.
+*/
+class RatingObserver: public Observer
+{
+    UnoGame * game;
+    RatingTable * table;
+    bool perSet;
+    std::vector<int> ids, places;
+    /// @brief Номера участников уже встреченных игроков.
+    std::unordered_map<const UnoPlayer *, int> knownIds;
+
+    /// @brief Обновляет номера участников по местам.
+    void refreshIds();
+    void recordGame(int winnerIndex);
+
+public:
+    RatingObserver(UnoGame * game, RatingTable * table, bool perSet = false);
+
+    void handleSetStarted(int gameNumber) override { refreshIds(); }
+    void handlePlayerWonSet(int playerIndex, int score) override;
+    void handlePlayerWonGame(int playerIndex, int totalScore) override
+        { recordGame(playerIndex); }
+    void handleSetsLimitReached(int winnerIndex, int winnerScore) override
+        { recordGame(winnerIndex); }
+};
@@ -0,0 +1,332 @@
+#include "selfplay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "training_data.h"
+
+/// @brief Законченная единица работы: решения игр, записанные одним потоком.
+struct SelfPlayUnit
+{
+    std::uint64_t id;
+    std::uint64_t games;
+    std::vector<DecisionBlock> blocks;
+};
+
+/**
+ * @brief Ограниченная очередь законченных единиц работы между симуляторами
+ * и потоком записи. Также хранит свободные блоки для переиспользования.
+*/
+class SelfPlayQueue
+{
+    std::mutex mutex;
+    std::condition_variable notEmpty, notFull;
+    std::deque<SelfPlayUnit> units;
+    std::vector<DecisionBlock> freeBlocks;
+    const size_t capacity;
+    bool closed;
+
+public:
+    explicit SelfPlayQueue(size_t capacity):
+        capacity(std::max<size_t>(capacity, 1)), closed(false) {}
+
+    /// @brief Добавляет единицу; ждет, если очередь заполнена.
+    void push(SelfPlayUnit&& unit)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return units.size() < capacity || closed; });
+        units.push_back(std::move(unit));
+        notEmpty.notify_one();
+    }
+
+    /// @brief Забирает единицу.
+    /// @return false, если очередь закрыта и пуста.
+    bool pop(SelfPlayUnit& unit)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return !units.empty() || closed; });
+        if (units.empty()) return false;
+        unit = std::move(units.front());
+        units.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    /// @brief Больше единиц не будет.
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    /// @brief Возвращает записанные блоки в пул.
+    void recycle(std::vector<DecisionBlock>& blocks)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (DecisionBlock& block : blocks)
+        {
+            block.clear();
+            freeBlocks.push_back(std::move(block));
+        }
+        blocks.clear();
+    }
+
+    /// @return пустой блок из пула или новый блок.
+    DecisionBlock takeBlock()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeBlocks.empty()) return DecisionBlock();
+        DecisionBlock block = std::move(freeBlocks.back());
+        freeBlocks.pop_back();
+        return block;
+    }
+};
+
+/// @brief Регистратор, который вместо записи в поток собирает блоки текущей
+/// единицы работы.
+class SelfPlayRecorder: public TrainingDataRecorder
+{
+    SelfPlayQueue& queue;
+    std::vector<DecisionBlock> blocks;
+
+protected:
+    size_t writeBlock(DecisionBlock& block) override
+    {
+        size_t size = decisionBlockBytes(block.rows());
+        blocks.push_back(std::move(block));
+        block = queue.takeBlock();
+        return size;
+    }
+
+public:
+    SelfPlayRecorder(SelfPlayQueue& queue, size_t blockRows):
+        TrainingDataRecorder(nullptr, blockRows), queue(queue), blocks() {}
+
+    ~SelfPlayRecorder() { flush(); }
+
+    /// @return блоки законченных партий единицы работы.
+    std::vector<DecisionBlock> takeBlocks()
+    {
+        flush();
+        std::vector<DecisionBlock> result;
+        result.swap(blocks);
+        return result;
+    }
+};
+
+/// @brief Стол одного потока: игра и ее игроки.
+struct SelfPlayTable
+{
+    UnoGame game;
+    std::vector<std::unique_ptr<UnoPlayer>> players;
+};
+
+static std::string shardName(int number)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "shard-%06d.bin", number);
+    return name;
+}
+
+/// @brief Читает манифест.
+/// @return номера записанных единиц работы; `shards` — число закрытых шардов.
+static std::set<std::uint64_t> readManifest(
+    const std::filesystem::path& manifest, int& shards)
+{
+    std::set<std::uint64_t> done;
+    shards = 0;
+    std::ifstream in(manifest);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream entry(line);
+        std::string file;
+        std::uint64_t bytes, decisions, games, unit;
+        if (!(entry >> file >> bytes >> decisions >> games)) continue;
+        ++shards;
+        while (entry >> unit) done.insert(unit);
+    }
+    return done;
+}
+
+SelfPlayReport runSelfPlay(const SelfPlayConfig &config)
+{
+    if (config.mixes.empty())
+        throw std::invalid_argument("No tables to play");
+    for (const auto& mix : config.mixes)
+        if (mix.empty()) throw std::invalid_argument("Empty table");
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::filesystem::path directory(config.outputDirectory);
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path manifestPath = directory / "manifest.txt";
+
+    const std::uint64_t gamesPerUnit = std::max(config.gamesPerUnit, 1);
+    const std::uint64_t numberOfUnits =
+        (config.numberOfGames + gamesPerUnit - 1) / gamesPerUnit;
+    auto unitGames = [&](std::uint64_t unit) {
+        return std::min(gamesPerUnit, config.numberOfGames - unit * gamesPerUnit);
+    };
+
+    SelfPlayReport report;
+    int shardNumber = 0;
+    const std::set<std::uint64_t> done = readManifest(manifestPath, shardNumber);
+    std::vector<std::uint64_t> todo;
+    for (std::uint64_t unit = 0; unit < numberOfUnits; ++unit)
+    {
+        if (done.count(unit)) report.skippedGames += unitGames(unit);
+        else todo.push_back(unit);
+    }
+
+    int threads = config.threads > 0
+        ? config.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+    SelfPlayQueue queue(config.queueCapacity);
+    std::atomic<size_t> nextUnit(0);
+    std::atomic<bool> stop(false);
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto simulate = [&]() {
+        try
+        {
+            std::vector<std::unique_ptr<SelfPlayTable>> tables;
+            SelfPlayRecorder recorder(queue, 1 << 14);
+            for (const auto& mix : config.mixes)
+            {
+                tables.emplace_back(new SelfPlayTable());
+                SelfPlayTable& table = *tables.back();
+                for (const PlayerFactory& factory : mix)
+                {
+                    table.players.push_back(factory());
+                    table.game.addPlayer(table.players.back().get());
+                }
+                table.game.addObserver(&recorder);
+                table.game.addDecisionObserver(&recorder);
+            }
+            while (!stop)
+            {
+                size_t index = nextUnit++;
+                if (index >= todo.size()) break;
+                const std::uint64_t unit = todo[index];
+                const std::uint64_t first = unit * gamesPerUnit;
+                const std::uint64_t games = unitGames(unit);
+                for (std::uint64_t i = first; i < first + games; ++i)
+                {
+                    SelfPlayTable& table = *tables[i % tables.size()];
+                    UnoGame& game = table.game;
+                    game.setRandomGeneratorSeed(config.seed + static_cast<unsigned>(i));
+                    // Сиды ботов зависят только от номера игры, так что
+                    // единица работы после возобновления повторяется точно
+                    for (size_t k = 0; k < table.players.size(); ++k)
+                    {
+                        std::seed_seq seq{ config.seed, static_cast<unsigned>(i),
+                            static_cast<unsigned>(k) };
+                        unsigned playerSeed;
+                        seq.generate(&playerSeed, &playerSeed + 1);
+                        table.players[k]->seed(playerSeed);
+                    }
+                    game.shufflePlayers();
+                    game.runGame();
+                }
+                queue.push(SelfPlayUnit{ unit, games, recorder.takeBlocks() });
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+            stop = true;
+        }
+    };
+
+    std::vector<std::thread> simulators;
+    for (int t = 0; t < threads; ++t) simulators.emplace_back(simulate);
+    std::thread closer([&]() {
+        for (std::thread& simulator : simulators) simulator.join();
+        queue.close();
+    });
+
+    // Поток записи — текущий поток
+    std::ofstream shard;
+    std::vector<char> shardBuffer(1 << 20);
+    std::uint64_t shardSize = 0, shardDecisions = 0, shardGames = 0;
+    std::vector<std::uint64_t> shardUnits;
+
+    auto elapsed = [&start]() {
+        return std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    };
+    auto closeShard = [&]() {
+        shard.close();
+        if (!shard) throw std::runtime_error("Cannot write shard");
+        std::ofstream manifest(manifestPath, std::ios::app);
+        manifest << shardName(shardNumber) << ' ' << shardSize << ' '
+                 << shardDecisions << ' ' << shardGames;
+        for (std::uint64_t unit : shardUnits) manifest << ' ' << unit;
+        manifest << '\n';
+        manifest.close();
+        if (!manifest) throw std::runtime_error("Cannot write manifest");
+        report.decisions += shardDecisions;
+        report.bytes += shardSize;
+        shardSize = shardDecisions = shardGames = 0;
+        shardUnits.clear();
+        ++report.shards;
+        report.seconds = elapsed();
+        if (config.progress) config.progress(report);
+    };
+
+    try
+    {
+        SelfPlayUnit unit;
+        while (queue.pop(unit))
+        {
+            if (!shard.is_open())
+            {
+                ++shardNumber;
+                shard.rdbuf()->pubsetbuf(shardBuffer.data(), shardBuffer.size());
+                shard.open(directory / shardName(shardNumber),
+                    std::ios::binary | std::ios::trunc);
+                if (!shard) throw std::runtime_error("Cannot open shard");
+            }
+            for (const DecisionBlock& block : unit.blocks)
+            {
+                shardSize += writeDecisionBlock(shard, block);
+                shardDecisions += block.rows();
+            }
+            queue.recycle(unit.blocks);
+            shardGames += unit.games;
+            shardUnits.push_back(unit.id);
+            report.games += unit.games;
+            if (shardSize >= config.shardBytes) closeShard();
+        }
+        if (shard.is_open()) closeShard();
+    }
+    catch (...)
+    {
+        stop = true;
+        queue.close();
+        closer.join();
+        throw;
+    }
+    closer.join();
+    if (error) std::rethrow_exception(error);
+
+    report.seconds = elapsed();
+    return report;
+}
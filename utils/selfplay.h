@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../game/uno_game.h"
+
+/// @brief Итоги генерации.
+struct SelfPlayReport
+{
+    /// @brief Игр сыграно в этом запуске.
+    std::uint64_t games = 0;
+    /// @brief Игр пропущено, потому что они уже записаны.
+    std::uint64_t skippedGames = 0;
+    /// @brief Решений записано.
+    std::uint64_t decisions = 0;
+    /// @brief Байт записано.
+    std::uint64_t bytes = 0;
+    /// @brief Шардов закрыто.
+    int shards = 0;
+    /// @brief Время работы в секундах.
+    double seconds = 0;
+
+    double decisionsPerSecond() const { return seconds > 0 ? decisions / seconds : 0; }
+    double bytesPerSecond() const     { return seconds > 0 ? bytes / seconds : 0; }
+};
+
+/// @brief Параметры генерации данных самоигры.
+struct SelfPlayConfig
+{
+    /// @brief Составы столов. Игра с номером `i` проводится за столом
+    /// `mixes[i % mixes.size()]`.
+    std::vector<std::vector<PlayerFactory>> mixes;
+
+    /// @brief Общее число игр.
+    std::uint64_t numberOfGames = 0;
+
+    /// @brief Число потоков-симуляторов, 0 — по числу ядер.
+    int threads = 0;
+
+    /// @brief Каталог для шардов и манифеста.
+    std::string outputDirectory = ".";
+
+    /// @brief Размер шарда в байтах; шард закрывается, когда его размер
+    /// достигает этого значения.
+    std::uint64_t shardBytes = std::uint64_t(256) << 20;
+
+    /// @brief Размер единицы работы в играх. Единица — минимальная часть
+    /// работы, которая попадает в один шард целиком и по которой
+    /// возобновляется прерванный запуск.
+    int gamesPerUnit = 64;
+
+    /// @brief Сколько законченных единиц может ждать записи.
+    int queueCapacity = 64;
+
+    /// @brief Базовый сид; игра с номером `i` получает сид `seed + i`, а
+    /// игроки ее стола — сиды из (`seed`, `i`, место в составе)
+    /// ( @see UnoPlayer::seed ).
+    unsigned seed = 0;
+
+    /// @brief Вызывается после закрытия каждого шарда из потока записи.
+    std::function<void(const SelfPlayReport&)> progress;
+};
+
+/**
+ * @brief Генерирует данные самоигры: проводит `numberOfGames` игр на всех
+ * ядрах и записывает каждое решение каждого игрока с итогом партии
+ * (см. TrainingDataRecorder) в шарды `shard-NNNNNN.bin`.
+ *
+ * @details Генерация, кодирование и запись разделены: потоки-симуляторы
+ * кодируют решения в блоки и передают законченные единицы работы в очередь,
+ * один поток записи пишет их в файлы. Блоки переиспользуются, так что в
+ * установившемся режиме память не выделяется.
+ *
+ * После закрытия шарда в `manifest.txt` дописывается строка
+ *
+ *     <файл> <байт> <решений> <игр> <номера единиц работы через пробел>
+ *
+ * При повторном запуске с тем же каталогом единицы, перечисленные в
+ * манифесте, пропускаются, а незакрытые шарды перезаписываются.
+ *
+ * @throws std::invalid_argument если состав стола пуст или некорректен.
+ * @throws std::runtime_error если не удается записать файл.
+*/
+SelfPlayReport runSelfPlay(const SelfPlayConfig& config);
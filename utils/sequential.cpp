@@ -0,0 +1,116 @@
+#include "sequential.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+double normalQuantile(double p)
+{
+    if (p <= 0 || p >= 1) throw std::domain_error("Quantile level must be in (0; 1)");
+    // Бисекция по функции распределения Φ(z) = erfc(−z / √2) / 2
+    double low = -40, high = 40;
+    for (int i = 0; i < 100; ++i)
+    {
+        const double middle = (low + high) / 2;
+        if (std::erfc(-middle / std::sqrt(2.0)) / 2 < p) low = middle;
+        else high = middle;
+    }
+    return (low + high) / 2;
+}
+
+/// @return половина ширины интервала Вильсона для доли `p` по `n` играм.
+/// В отличие от интервала Вальда, она не равна нулю, если все игры
+/// выиграны или все проиграны.
+static double wilsonHalfWidth(double p, double n, double z)
+{
+    const double z2n = z * z / n;
+    return z / (1 + z2n) * std::sqrt(p * (1 - p) / n + z2n / (4 * n));
+}
+
+static void checkConfig(const UnoGame& game, const SequentialTestConfig& config)
+{
+    if (config.player == nullptr || config.player->playerIndex() < 0
+        || config.player->playerIndex() >= game.numberOfPlayers())
+        throw std::invalid_argument("Tested player is not in the game");
+    const bool sprt = config.p0 != config.p1;
+    if (!sprt && config.targetError <= 0)
+        throw std::invalid_argument("No stopping rule");
+    if (sprt && (config.p0 <= 0 || config.p0 >= 1 || config.p1 <= 0 || config.p1 >= 1
+        || config.alpha <= 0 || config.alpha >= 1 || config.beta <= 0 || config.beta >= 1))
+        throw std::invalid_argument("Invalid SPRT parameters");
+    if (config.confidence <= 0 || config.confidence >= 1)
+        throw std::invalid_argument("Invalid confidence level");
+    if (config.batchSize <= 0)
+        throw std::invalid_argument("Invalid batch size");
+}
+
+SequentialTestResult runSequentialTest(
+    UnoGame &game,
+    const SequentialTestConfig &config,
+    unsigned seed)
+{
+    checkConfig(game, config);
+    const int n = game.numberOfPlayers();
+    const bool sprt = config.p0 != config.p1;
+    const double lower = std::log(config.beta / (1 - config.alpha));
+    const double upper = std::log((1 - config.beta) / config.alpha);
+    const double winStep = sprt ? std::log(config.p1 / config.p0) : 0;
+    const double lossStep = sprt ? std::log((1 - config.p1) / (1 - config.p0)) : 0;
+    const double z = normalQuantile((1 + config.confidence) / 2);
+
+    // order[0] — проверяемый игрок, дальше остальные в порядке мест
+    std::vector<UnoPlayer*> base(n), order(n), seating(n);
+    for (int i = 0; i < n; ++i) base[i] = game.player(i);
+    const int first = config.player->playerIndex();
+    for (int k = 0; k < n; ++k) order[k] = base[(first + k) % n];
+
+    SequentialTestResult result;
+    result.wins = MomentAccumulator(1);
+    double won = 0;
+
+    while (result.games < config.maxGames)
+    {
+        const std::uint64_t batchEnd = std::min<std::uint64_t>(
+            config.maxGames, result.games + config.batchSize);
+        for (; result.games < batchEnd; ++result.games)
+        {
+            for (int k = 0; k < n; ++k)
+                seating[(k + result.games) % n] = order[k];
+            seatPlayers(game, seating);
+            game.setRandomGeneratorSeed(seed + static_cast<unsigned>(result.games));
+            const int winner = std::get<0>(game.runGame());
+            won = winner >= 0 && winner == config.player->playerIndex();
+            result.wins.add(&won);
+            result.llr += won ? winStep : lossStep;
+        }
+
+        result.winRate = result.wins.mean(0);
+        result.error = wilsonHalfWidth(result.winRate, result.games, z);
+        if (config.progress) config.progress(result.games, result.winRate);
+
+        if (sprt && result.llr >= upper)
+            result.decision = SequentialTestResult::AcceptedH1;
+        else if (sprt && result.llr <= lower)
+            result.decision = SequentialTestResult::AcceptedH0;
+        else if (config.targetError > 0 && result.games > 1
+            && result.error <= config.targetError)
+            result.decision = SequentialTestResult::ErrorBoundMet;
+        else continue;
+        break;
+    }
+    seatPlayers(game, base);
+
+    if (sprt && result.games > 0)
+    {
+        // Интервал Вильсона не содержит middle, пока score-статистика с
+        // дисперсией доли при middle больше квантили; middle в (0; 1), так
+        // что дисперсия не равна нулю
+        const double middle = (config.p0 + config.p1) / 2;
+        const double se = std::sqrt(middle * (1 - middle) / result.games);
+        const double distance = std::abs(result.winRate - middle);
+        result.achievedConfidence = 1 - std::erfc(distance / se / std::sqrt(2.0));
+    }
+    else result.achievedConfidence = config.confidence;
+    return result;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "../game/uno_game.h"
+#include "stats.h"
+
+/// @brief Параметры последовательной проверки доли побед игрока.
+struct SequentialTestConfig
+{
+    /// @brief Проверяемый игрок; он уже должен быть добавлен в игру.
+    UnoPlayer * player = nullptr;
+
+    /// @brief Гипотезы SPRT: H0 — доля побед `p0`, H1 — доля побед `p1`.
+    /// Если `p0 == p1`, SPRT не проводится и остановка происходит только по
+    /// ширине доверительного интервала.
+    double p0 = 0.5, p1 = 0.5;
+    /// @brief Допустимые вероятности ошибок первого и второго рода.
+    double alpha = 0.05, beta = 0.05;
+
+    /// @brief Остановиться, когда половина ширины доверительного интервала
+    /// Вильсона доли побед не больше этого значения; 0 — не использовать.
+    double targetError = 0;
+    /// @brief Уровень доверия для интервала.
+    double confidence = 0.95;
+
+    /// @brief Через сколько игр проверяется условие остановки.
+    int batchSize = 100;
+    /// @brief Наибольшее число игр.
+    std::uint64_t maxGames = 100000;
+
+    /// @brief Вызывается после каждой пачки с числом игр и долей побед.
+    std::function<void(std::uint64_t, double)> progress;
+};
+
+/// @brief Итоги последовательной проверки.
+struct SequentialTestResult
+{
+    enum Decision
+    {
+        /// @brief SPRT принял H0.
+        AcceptedH0,
+        /// @brief SPRT принял H1.
+        AcceptedH1,
+        /// @brief Доверительный интервал достиг нужной ширины.
+        ErrorBoundMet,
+        /// @brief Сыграно `maxGames` игр, решение не принято.
+        GamesLimitReached
+    };
+
+    Decision decision = GamesLimitReached;
+    /// @brief Сыграно игр.
+    std::uint64_t games = 0;
+    /// @brief Доля побед проверяемого игрока.
+    double winRate = 0;
+    /// @brief Половина ширины доверительного интервала Вильсона доли побед
+    /// на уровне `SequentialTestConfig::confidence`. Интервал смещен от
+    /// `winRate` к 1/2 и не вырождается при 0 или всех победах.
+    double error = 0;
+    /// @brief Логарифм отношения правдоподобия H1 к H0.
+    double llr = 0;
+    /// @brief Достигнутый уровень доверия: для SPRT — наибольший уровень, на
+    /// котором интервал Вильсона доли побед не содержит (p0 + p1) / 2, иначе —
+    /// `SequentialTestConfig::confidence`.
+    double achievedConfidence = 0;
+    /// @brief Потоковая статистика побед проверяемого игрока (1 — победа).
+    MomentAccumulator wins;
+};
+
+/**
+ * @brief Проводит игры пачками, пока гипотеза о доле побед игрока не
+ * решена последовательным критерием отношения вероятностей (SPRT) или пока
+ * доверительный интервал не стал достаточно узким.
+ * @details Игра `g` проводится с сидом `seed + g`, проверяемый игрок сидит на
+ * месте `g % numberOfPlayers()`, остальные — по кругу за ним. Границы SPRT:
+ * ln(β / (1 − α)) и ln((1 − β) / α). После проверки игроки рассаживаются как
+ * до нее.
+ * @throws std::invalid_argument если игрок не участвует в игре, параметры
+ * некорректны или не задано ни одно условие остановки.
+*/
+SequentialTestResult runSequentialTest(
+    UnoGame& game,
+    const SequentialTestConfig& config,
+    unsigned seed = 0);
+
+/// @return квантиль стандартного нормального распределения уровня `p`.
+double normalQuantile(double p);
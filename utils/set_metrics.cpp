@@ -0,0 +1,96 @@
+#include "set_metrics.h"
+
+SetMetricsObserver::SetMetricsObserver(const UnoGame *game):
+    game(game),
+    shuffles(0), draws(0), disqualifications(0), drewThisTurn(false),
+    turns(), reshuffles(), drawnCards(), disqualified(), winnerScores(),
+    handSizes(), turnsLimitedSets(0)
+{}
+
+void SetMetricsObserver::handleSetStarted(int gameNumber)
+{
+    shuffles = draws = disqualifications = 0;
+    drewThisTurn = false;
+}
+
+void SetMetricsObserver::handleCardPlayed(int playerIndex, const Card *card)
+{
+    // Ход со взятием карты уже учтен
+    if (!drewThisTurn) recordTurn(playerIndex);
+    drewThisTurn = false;
+}
+
+void SetMetricsObserver::handlePlayerDrewAnotherCard(int playerIndex)
+{
+    ++draws;
+    recordTurn(playerIndex);
+    drewThisTurn = true;
+}
+
+void SetMetricsObserver::handlePlayerDrewAndSkip(int playerIndex, int numberOfCards)
+{
+    draws += numberOfCards;
+    recordTurn(playerIndex);
+    drewThisTurn = false;
+}
+
+void SetMetricsObserver::finishSet()
+{
+    turns.record(game->currentTurnNumber());
+    // Первое перемешивание — подготовка колоды к раздаче
+    reshuffles.record(shuffles > 0 ? shuffles - 1 : 0);
+    drawnCards.record(draws);
+    disqualified.record(disqualifications);
+}
+
+void SetMetricsObserver::handlePlayerWonSet(int playerIndex, int score)
+{
+    finishSet();
+    winnerScores.record(score < 0 ? 0 : score);
+}
+
+void SetMetricsObserver::handleTurnsLimitReached()
+{
+    finishSet();
+    ++turnsLimitedSets;
+}
+
+void SetMetricsObserver::merge(const SetMetricsObserver &other)
+{
+    turns.merge(other.turns);
+    reshuffles.merge(other.reshuffles);
+    drawnCards.merge(other.drawnCards);
+    disqualified.merge(other.disqualified);
+    winnerScores.merge(other.winnerScores);
+    handSizes.merge(other.handSizes);
+    turnsLimitedSets += other.turnsLimitedSets;
+}
+
+void SetMetricsObserver::clear()
+{
+    turns.clear();
+    reshuffles.clear();
+    drawnCards.clear();
+    disqualified.clear();
+    winnerScores.clear();
+    handSizes.clear();
+    turnsLimitedSets = 0;
+}
+
+void SetMetricsObserver::printSummary(std::ostream &out) const
+{
+    out << "Metric\tCount\tMean\tP50\tP90\tP99\tP99.9\tMax\n";
+    auto print = [&](const char * name, const LogLinearHistogram& histogram) {
+        out << name << '\t' << histogram.count() << '\t' << histogram.mean()
+            << '\t' << histogram.percentile(0.5) << '\t' << histogram.percentile(0.9)
+            << '\t' << histogram.percentile(0.99) << '\t' << histogram.percentile(0.999)
+            << '\t' << histogram.max() << '\n';
+    };
+    print("SetTurns", turns);
+    print("Reshuffles", reshuffles);
+    print("DrawnCards", drawnCards);
+    print("Disqualifications", disqualified);
+    print("WinnerScore", winnerScores);
+    print("HandSize", handSizes);
+    out << "TurnsLimitedSets\t" << turnsLimitedSets << '\n';
+}
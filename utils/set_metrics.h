@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+#include "../game/uno_game.h"
+#include "histogram.h"
+
+/**
+ * @brief Наблюдатель, собирающий распределения показателей каждой партии и
+ * каждого хода в гистограммы фиксированного размера.
+ *
+ * @details По партиям: число ходов, число перемешиваний колоды после
+ * раздачи, число взятых карт, число дисквалификаций и очки победителя. По
+ * ходам: число карт у сходившего игрока после хода. Наблюдатели разных
+ * потоков объединяются методом `merge`.
+*/
+class SetMetricsObserver: public Observer
+{
+    const UnoGame * game;
+
+    // Счетчики текущей партии
+    unsigned shuffles, draws, disqualifications;
+    /// @brief true, если текущий ход начался со взятия карты.
+    bool drewThisTurn;
+
+    /// @brief Учитывает законченную партию.
+    void finishSet();
+    void recordTurn(int playerIndex)
+        { handSizes.record(game->cardsOf(playerIndex)); }
+
+public:
+    LogLinearHistogram turns, reshuffles, drawnCards, disqualified, winnerScores;
+    LogLinearHistogram handSizes;
+    /// @brief Партий, закончившихся по ограничению числа ходов.
+    std::uint64_t turnsLimitedSets;
+
+    explicit SetMetricsObserver(const UnoGame * game);
+
+    /// @brief Добавляет статистику другого наблюдателя.
+    void merge(const SetMetricsObserver& other);
+    void clear();
+
+    /// @brief Печатает для каждого показателя число значений, среднее,
+    /// процентили 50/90/99/99.9 и максимум в формате TSV.
+    void printSummary(std::ostream& out) const;
+
+    // Методы наблюдателя
+
+    void handleSetStarted(int gameNumber) override;
+    void handleDeckShuffled() override { ++shuffles; }
+    void handleCardPlayed(int playerIndex, const Card * card) override;
+    void handlePlayerDrewAnotherCard(int playerIndex) override;
+    void handlePlayerDrewAndSkip(int playerIndex, int numberOfCards) override;
+    void handlePlayerDisqualified(int playerIndex, int handScore, const Card * card) override
+        { ++disqualifications; drewThisTurn = false; }
+    void handlePlayerWonSet(int playerIndex, int score) override;
+    void handleTurnsLimitReached() override;
+};
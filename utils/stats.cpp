@@ -1,39 +1,186 @@
 #include "stats.h"
 
+#include <algorithm>
+
+#include "export.h"
+
+MomentAccumulator::MomentAccumulator(int dimension):
+    dimension_(dimension),
+    count_(0),
+    mean_(dimension, 0),
+    comoments_(static_cast<size_t>(dimension) * (dimension + 1) / 2, 0),
+    delta_(dimension, 0)
+{}
+
+void MomentAccumulator::merge(const MomentAccumulator &other)
+{
+    if (other.dimension_ != dimension_)
+        throw std::invalid_argument("Cannot merge accumulators of different dimensions");
+    if (other.count_ == 0) return;
+    if (count_ == 0)
+    {
+        count_ = other.count_;
+        mean_ = other.mean_;
+        comoments_ = other.comoments_;
+        return;
+    }
+    // Формула Чана для объединения двух выборок
+    const double total = static_cast<double>(count_) + other.count_;
+    const double scale = static_cast<double>(count_) * other.count_ / total;
+    for (int i = 0; i < dimension_; ++i)
+        delta_[i] = other.mean_[i] - mean_[i];
+    for (int i = 0; i < dimension_; ++i)
+        for (int j = i; j < dimension_; ++j)
+            comoments_[at(i, j)] += other.comoments_[at(i, j)]
+                + scale * delta_[i] * delta_[j];
+    for (int i = 0; i < dimension_; ++i)
+        mean_[i] += delta_[i] * other.count_ / total;
+    count_ += other.count_;
+}
+
+double MomentAccumulator::covariance(int i, int j) const
+{
+    if (count_ == 0) throw std::underflow_error("Cannot calculate covariation for empty sequence");
+    return comoments_[i <= j ? at(i, j) : at(j, i)] / count_;
+}
+
+void MomentAccumulator::clear()
+{
+    count_ = 0;
+    std::fill(mean_.begin(), mean_.end(), 0);
+    std::fill(comoments_.begin(), comoments_.end(), 0);
+}
+
+StatsObserver::MV StatsObserver::getMV(const MomentAccumulator &accumulator)
+{
+    const int n = accumulator.dimension();
+    std::vector<double> meanVector(n);
+    std::vector<std::vector<double>> var(n, std::vector<double>(n));
+    for (int i = 0; i < n; ++i)
+    {
+        meanVector[i] = accumulator.mean(i);
+        for (int j = 0; j < n; ++j)
+            var[i][j] = accumulator.covariance(i, j);
+    }
+    return { meanVector, var };
+}
+
+StatsObserver::MV StatsObserver::getWinsMV(const GameResults &results)
+{
+    const int n = results.players();
+    MomentAccumulator accumulator(n);
+    std::vector<double> sample(n);
+    for (size_t g = 0; g < results.size(); ++g)
+    {
+        for (int i = 0; i < n; ++i) sample[i] = results.winner(g) == i;
+        accumulator.add(sample.begin());
+    }
+    return getMV(accumulator);
+}
+
+StatsObserver::MV StatsObserver::getScoresMV(const GameResults &results)
+{
+    const int n = results.players();
+    MomentAccumulator accumulator(n);
+    std::vector<double> sample(n);
+    for (size_t g = 0; g < results.size(); ++g)
+    {
+        for (int i = 0; i < n; ++i) sample[i] = results.score(g, i);
+        accumulator.add(sample.begin());
+    }
+    return getMV(accumulator);
+}
+
 void StatsObserver::assureIsAllocated() 
 {
-    if (!wins.empty()) return;
-    wins.resize(game->numberOfPlayers());
-    scores.resize(game->numberOfPlayers());
+    if (winsMoments.dimension() == game->numberOfPlayers()) return;
+    winsMoments = MomentAccumulator(game->numberOfPlayers());
+    scoresMoments = MomentAccumulator(game->numberOfPlayers());
+    sample.resize(game->numberOfPlayers());
+    if (results.players() != game->numberOfPlayers())
+        results = GameResults(game->numberOfPlayers());
 }
 
 void StatsObserver::registerWin(int winnerIndex) 
 {
     if (winnerIndex < 0) return;
     assureIsAllocated();
-    for (int i = 0; i < wins.size(); i++)
-        wins.at(i).push_back(i == winnerIndex);
-    const auto playerScores = game->currentScores();
-    for (int i = 0; i < scores.size(); i++)
-        scores.at(i).push_back(playerScores.at(i));
+    const int n = static_cast<int>(sample.size());
+    for (int i = 0; i < n; i++)
+        sample[i] = i == winnerIndex;
+    winsMoments.add(sample.begin());
+
+    scoresMoments.add(game->scores().begin());
+
+    if (keepResults) results.add(*game, winnerIndex, gameTurns);
 }
 
-StatsObserver::StatsObserver(const UnoGame * game): 
-  game(game), wins(), scores()
+StatsObserver::StatsObserver(const UnoGame * game, bool keepResults): 
+  results(), gameTurns(0), game(game), keepResults(keepResults)
 {}
 
 void StatsObserver::reserve(int numberOfPlayers, size_t numberOfGames)
 {
-    wins.resize(numberOfPlayers);
-    scores.resize(numberOfPlayers);
+    if (!keepResults) return;
+    if (results.players() != numberOfPlayers) results = GameResults(numberOfPlayers);
+    results.reserve(numberOfGames);
+}
+
+void StatsObserver::merge(const StatsObserver &other)
+{
+    if (other.numberOfGames() == 0) return;
+    if (numberOfGames() == 0 && winsMoments.dimension() == 0)
+    {
+        winsMoments = MomentAccumulator(other.winsMoments.dimension());
+        scoresMoments = MomentAccumulator(other.scoresMoments.dimension());
+        sample.resize(other.winsMoments.dimension());
+    }
+    winsMoments.merge(other.winsMoments);
+    scoresMoments.merge(other.scoresMoments);
+    if (!keepResults || !other.keepResults) return;
+    if (results.size() == 0 && results.players() != other.results.players())
+        results = GameResults(other.results.players());
+    results.append(other.results);
+}
+
+/// @brief Печатает столбцы `value(g, i)` по всем играм в формате TSV.
+template<class F>
+static void printResultsTSV(const GameResults& results, std::ostream& out, F value)
+{
+    BufferedWriter writer(out);
+    for (int i = 0; i < results.players(); ++i)
+    {
+        writer.write("Player", 6);
+        writer.writeInt(i);
+        writer.put('\t');
+    }
+    writer.put('\n');
+    for (size_t g = 0; g < results.size(); ++g)
+    {
+        for (int i = 0; i < results.players(); ++i)
+        {
+            writer.writeInt(value(g, i));
+            writer.put('\t');
+        }
+        writer.put('\n');
+    }
+}
+
+void StatsObserver::printScoresTSV(std::ostream &out) const
+{
+    if (!keepResults) throw std::logic_error("Game results are not kept");
+    printResultsTSV(results, out, [&](size_t g, int i) { return results.score(g, i); });
+}
 
-    for (auto& vec: wins) vec.reserve(numberOfGames);
-    for (auto& vec: scores) vec.reserve(numberOfGames);
+void StatsObserver::printWinsTSV(std::ostream &out) const
+{
+    if (!keepResults) throw std::logic_error("Game results are not kept");
+    printResultsTSV(results, out, [&](size_t g, int i) { return results.winner(g) == i ? 1 : 0; });
 }
 
-StatsObserver runGames(UnoGame& game, int numberOfGames)
+StatsObserver runGames(UnoGame& game, int numberOfGames, bool keepResults)
 {
-    StatsObserver observer(&game);
+    StatsObserver observer(&game, keepResults);
     observer.reserve(game.numberOfPlayers(), numberOfGames);
     game.addObserver(&observer);
     for(int i = 0; i < numberOfGames; ++i) 
@@ -43,3 +190,29 @@ StatsObserver runGames(UnoGame& game, int numberOfGames)
     }
     return observer;
 }
+
+void seatPlayers(UnoGame& game, const std::vector<UnoPlayer*>& order)
+{
+    const int n = game.numberOfPlayers();
+    if (static_cast<int>(order.size()) != n)
+        throw std::invalid_argument("Seating must include every player");
+    // current[k] — игрок, который сейчас сидит на месте k
+    std::vector<UnoPlayer*> current(n, nullptr);
+    for (UnoPlayer * player : order)
+    {
+        const int seat = player->playerIndex();
+        if (seat < 0 || seat >= n || current[seat] != nullptr)
+            throw std::invalid_argument("Seating is not a permutation of players");
+        current[seat] = player;
+    }
+    // shufflePlayers меняет местами i-того и permutation[i]-того игроков
+    std::vector<int> permutation(n);
+    for (int i = 0; i < n; ++i)
+    {
+        const int j = std::find(current.begin() + i, current.end(), order[i]) 
+            - current.begin();
+        permutation[i] = j;
+        std::swap(current[i], current[j]);
+    }
+    game.shufflePlayers(permutation);
+}
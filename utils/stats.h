@@ -1,19 +1,70 @@
 #pragma once
 
+#include <cstdint>
 #include <ostream>
 #include <stdexcept>
 #include <vector>
 
 #include "../game/uno_game.h"
+#include "game_results.h"
 
 
-class StatsObserver : public Observer
+/**
+ * @brief Потоковый подсчет среднего и матрицы ковариации многомерной выборки
+ * по алгоритму Уэлфорда.
+ * @details Хранит число наблюдений, средние и совместные центральные моменты,
+ * поэтому занимает O(dimension²) памяти независимо от числа наблюдений.
+ * Накопители, заполненные в разных потоках, объединяются методом `merge`.
+*/
+class MomentAccumulator
 {
+    int dimension_;
+    std::uint64_t count_;
+    std::vector<double> mean_;
+    /// @brief Верхний треугольник симметричной матрицы: comoments_[at(i, j)]
+    /// при i <= j — сумма произведений отклонений `i`-той и `j`-той
+    /// компонент от их средних. Вдвое меньше памяти и работы на наблюдение,
+    /// что заметно при десятках игроков.
+    std::vector<double> comoments_;
+    /// @brief отклонения последнего наблюдения, чтобы не выделять память
+    std::vector<double> delta_;
+
+    /// @return позиция элемента (i, j), i <= j, в comoments_.
+    size_t at(int i, int j) const
+    {
+        return static_cast<size_t>(i) * dimension_ 
+            - static_cast<size_t>(i) * (i - 1) / 2 + (j - i);
+    }
 
 public:
-    template<class T>
-    using Table = std::vector<std::vector<T>>;
+    explicit MomentAccumulator(int dimension = 0);
+
+    int dimension() const { return dimension_; }
+    std::uint64_t count() const { return count_; }
+
+    /// @brief Добавляет наблюдение из `dimension()` компонент.
+    template<class iterator>
+    void add(iterator begin);
+
+    /// @brief Добавляет к накопителю наблюдения из `other`.
+    /// @throws std::invalid_argument если размерности различаются.
+    void merge(const MomentAccumulator& other);
+
+    /// @return среднее `i`-той компоненты.
+    double mean(int i) const { return mean_[i]; }
+    /// @return ковариация `i`-той и `j`-той компонент (деленная на число
+    /// наблюдений, как и в `cov`).
+    /// @throws std::underflow_error если наблюдений нет.
+    double covariance(int i, int j) const;
+
+    void clear();
+};
+
+
+class StatsObserver : public Observer
+{
 
+public:
     /// @brief Структура, хранящая базовую статистическую информацию
     /// о многомерном наборе данных. Возвращается методами `getWinsMV` и `getScoresMV`. 
     struct MV
@@ -25,31 +76,54 @@ public:
         std::vector<std::vector<double>> var;
     };
 
+    /// @return среднее и матрица ковариации накопителя.
+    /// @throws std::underflow_error если наблюдений нет.
+    static MV getMV(const MomentAccumulator& accumulator);
+
+    /// @return среднее и матрица ковариации побед игроков по результатам игр.
+    /// @throws std::underflow_error если результатов нет.
+    static MV getWinsMV(const GameResults& results);
+    /// @return среднее и матрица ковариации очков игроков по результатам игр.
+    /// @throws std::underflow_error если результатов нет.
+    static MV getScoresMV(const GameResults& results);
+
 private: 
-    /// @brief scores[i][j] — очки `i`-того игрока в `j`-тую игру
-    Table<int> scores;
-    /// @brief scores[i][j] — true, если `i`-тый игрок выиграл `j`-тую игру
-    Table<bool> wins;
+    /// @brief результаты каждой игры; заполняются, только если включено их
+    /// хранение
+    GameResults results;
+    /// @brief число ходов во всех партиях текущей игры
+    unsigned gameTurns;
+
+    /// @brief потоковые статистики побед и очков
+    MomentAccumulator winsMoments, scoresMoments;
+    /// @brief буфер для очередного наблюдения
+    std::vector<double> sample;
 
     /// @brief указатель на игру, за которой наблюдает объект
     const UnoGame * game;
-
-    /// @brief печать таблицы в поток вывода
-    template<class T>
-    void printTSV(const Table<T>&, std::ostream&) const;
-
-    /// @brief подсчет среднего и матрицы ковариации
-    template<class T>
-    MV getMV(const Table<T>&) const;
+    bool keepResults;
 
     void assureIsAllocated();
     void registerWin(int winnerIndex);
 public:
-    StatsObserver(const UnoGame* game);
+    /// @param keepResults хранить ли результаты каждой игры (GameResults);
+    /// без них доступны только средние и ковариации, зато память не растет
+    /// с числом игр.
+    StatsObserver(const UnoGame* game, bool keepResults = false);
 
-    /// @brief резервирует место во всех векторах
+    /// @brief резервирует место под результаты
     void reserve(int numberOfPlayers, size_t numberOfGames);
 
+    /// @brief Добавляет статистику другого наблюдателя за игрой с тем же
+    /// числом игроков, например, собранную в другом потоке. Результаты игр
+    /// дописываются, если они хранятся у обоих наблюдателей.
+    /// @throws std::invalid_argument если число игроков различается.
+    void merge(const StatsObserver& other);
+
+    /// @return число учтенных игр.
+    std::uint64_t numberOfGames() const { return winsMoments.count(); }
+    bool keepsResults() const { return keepResults; }
+
 
     // Методы наблюдателя
      
@@ -59,27 +133,48 @@ public:
     void handleSetsLimitReached(int winnerIndex, int winnerScore) override 
         { registerWin(winnerIndex); }
 
-    const Table<int>& getScores() const { return scores; }
-    const Table<bool>& getWins() const  { return wins;   }
+    void handleSetStarted(int gameNumber) override 
+        { if (gameNumber == 1) gameTurns = 0; }
+
+    void handlePlayerWonSet(int playerIndex, int score) override 
+        { gameTurns += game->currentTurnNumber(); }
+
+    void handleTurnsLimitReached() override 
+        { gameTurns += game->currentTurnNumber(); }
+
+    /// @brief Результаты игр; пусты, если их хранение не включено.
+    const GameResults& getResults() const { return results; }
+
+    const MomentAccumulator& getScoresMoments() const { return scoresMoments; }
+    const MomentAccumulator& getWinsMoments() const   { return winsMoments;   }
 
     /// @brief вывод количества очков за все игры в формате TSV в поток вывода
-    void printScoresTSV(std::ostream& out) const { return printTSV(scores, out); }
+    /// @throws std::logic_error если результаты игр не хранятся.
+    void printScoresTSV(std::ostream& out) const;
 
     /// @brief вывод победивших игроков за все игры в формате TSV в поток вывода
-    void printWinsTSV(std::ostream& out) const   { return printTSV(wins, out);   }
+    /// @throws std::logic_error если результаты игр не хранятся.
+    void printWinsTSV(std::ostream& out) const;
 
-    /// @brief подсчет среднего и матрицы ковариации для очков игроков
-    MV getScoresMV() const { return getMV(scores); } 
+    /// @brief среднее и матрица ковариации для очков игроков, за O(игроков²)
+    MV getScoresMV() const { return getMV(scoresMoments); } 
 
-    /// @brief подсчет среднего и матрицы ковариации для побед игроков
-    MV getWinsMV() const   { return getMV(wins);   }
+    /// @brief среднее и матрица ковариации для побед игроков, за O(игроков²)
+    MV getWinsMV() const   { return getMV(winsMoments);   }
 };
 
 
 /// @brief Запуск `numberOfGames` игр подряд с подсчетом статистики.
 /// Предполагается, что в `game` уже добавлены все игроки.
 /// После каждой игры игроки меняются местами.
-StatsObserver runGames(UnoGame& game, int numberOfGames);
+/// @param keepResults хранить ли результаты каждой игры ( @see StatsObserver ).
+StatsObserver runGames(UnoGame& game, int numberOfGames, bool keepResults = false);
+
+/// @brief Рассаживает игроков игры в порядке `order`.
+/// @param order все игроки игры в нужном порядке.
+/// @throws std::invalid_argument если `order` не является перестановкой
+/// игроков игры.
+void seatPlayers(UnoGame& game, const std::vector<UnoPlayer*>& order);
 
 /// @brief Расчет среднего значения последовательности
 /// @throws std::underflow_error если begin == end
@@ -117,33 +212,21 @@ double cov(iterator begin1, iterator end1, iterator begin2)
     return sumProd / count - (sum1 / count) * (sum2 / count);
 }
 
-template<class T>
-StatsObserver::MV StatsObserver::getMV(const Table<T>& table) const
-{
-  std::vector<double> meanVector(table.size());
-  std::vector<std::vector<double>> var(table.size(), std::vector<double>(table.size()));
-  
-  for (int i = 0; i < table.size(); ++i)
-  {
-      meanVector[i] = mean(table[i].begin(), table[i].end());
-      for (int j = i; j < table.size(); ++j) 
-          var[i][j] = var[j][i] = 
-              cov(table[i].begin(), table[i].end(), table[j].begin());
-  }
-
-  return { meanVector, var };
-}
-
-template<class T>
-void StatsObserver::printTSV(const Table<T>& table, std::ostream& out) const 
+template<class iterator>
+void MomentAccumulator::add(iterator begin)
 {
-    for (int i = 0; i < table.size(); ++i)
-        out << "Player" << i << '\t';
-    out << '\n';
-    for (int j = 0; j < table.front().size(); ++j) 
+    ++count_;
+    for (int i = 0; i < dimension_; ++i, ++begin)
+    {
+        delta_[i] = *begin - mean_[i];
+        mean_[i] += delta_[i] / count_;
+    }
+    // После обновления средних: C_ij += (x_i - старое m_i) * (x_j - новое m_j)
+    const double scale = static_cast<double>(count_ - 1) / count_;
+    for (int i = 0; i < dimension_; ++i)
     {
-        for (int i = 0; i < table.size(); ++i)
-            out << table[i][j] << '\t';
-        out << '\n';
+        const double scaled = scale * delta_[i];
+        double * row = &comoments_[at(i, i)];
+        for (int j = i; j < dimension_; ++j) row[j - i] += scaled * delta_[j];
     }
 }
@@ -0,0 +1,199 @@
+#include "tournament.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include "parallel.h"
+#include "stats.h"
+
+using Matrix = std::vector<std::vector<std::uint64_t>>;
+
+double TournamentResult::winRate(int i) const
+{
+    const std::uint64_t played = games.at(i).at(i);
+    return played == 0 ? 0 : static_cast<double>(wins[i][i]) / played;
+}
+
+double TournamentResult::pairScore(int i, int j) const
+{
+    const std::uint64_t played = games.at(i).at(j);
+    if (played == 0) return 0;
+    // Ничьи — игры, в которых ни один не набрал больше другого
+    const std::uint64_t draws = played - ahead[i][j] - ahead[j][i];
+    return (ahead[i][j] + draws / 2.0) / played;
+}
+
+/// @return число сочетаний из `n` по `k` или `limit + 1`, если оно больше `limit`.
+static std::uint64_t combinations(int n, int k, std::uint64_t limit)
+{
+    std::uint64_t result = 1;
+    for (int i = 1; i <= k; ++i)
+    {
+        // C(n - k + i, i) = C(n - k + i - 1, i - 1) * (n - k + i) / i
+        result = result * (n - k + i) / i;
+        if (result > limit) return limit + 1;
+    }
+    return result;
+}
+
+std::vector<std::vector<int>> scheduleTables(
+    int rosterSize, int tableSize, std::uint64_t maxTables, unsigned seed)
+{
+    std::vector<std::vector<int>> tables;
+    if (tableSize <= 0 || tableSize > rosterSize) return tables;
+
+    if (maxTables == 0 || combinations(rosterSize, tableSize, maxTables) <= maxTables)
+    {
+        // Все сочетания в лексикографическом порядке
+        std::vector<int> table(tableSize);
+        for (int k = 0; k < tableSize; ++k) table[k] = k;
+        for (;;)
+        {
+            tables.push_back(table);
+            int k = tableSize - 1;
+            while (k >= 0 && table[k] == rosterSize - tableSize + k) --k;
+            if (k < 0) break;
+            ++table[k];
+            for (int m = k + 1; m < tableSize; ++m) table[m] = table[m - 1] + 1;
+        }
+        return tables;
+    }
+
+    std::mt19937 random(seed);
+    std::vector<std::uint64_t> appearances(rosterSize, 0);
+    Matrix meetings(rosterSize, std::vector<std::uint64_t>(rosterSize, 0));
+    std::vector<int> candidates(rosterSize);
+    for (std::uint64_t t = 0; t < maxTables; ++t)
+    {
+        std::vector<int> table;
+        for (int k = 0; k < tableSize; ++k)
+        {
+            // Случайный порядок разрешает равенства без перекоса к первым номерам
+            for (int i = 0; i < rosterSize; ++i) candidates[i] = i;
+            std::shuffle(candidates.begin(), candidates.end(), random);
+            int best = -1;
+            std::uint64_t bestAppearances = 0, bestMeetings = 0;
+            for (int i : candidates)
+            {
+                if (std::find(table.begin(), table.end(), i) != table.end()) continue;
+                std::uint64_t met = 0;
+                for (int j : table) met += meetings[i][j];
+                if (best < 0 || appearances[i] < bestAppearances
+                    || (appearances[i] == bestAppearances && met < bestMeetings))
+                {
+                    best = i;
+                    bestAppearances = appearances[i];
+                    bestMeetings = met;
+                }
+            }
+            for (int j : table) ++meetings[best][j], ++meetings[j][best];
+            ++appearances[best];
+            table.push_back(best);
+        }
+        std::sort(table.begin(), table.end());
+        tables.push_back(table);
+    }
+    return tables;
+}
+
+/// @brief Стол, за которым поток проводит игры.
+struct TournamentTable
+{
+    UnoGame game;
+    std::vector<std::unique_ptr<UnoPlayer>> players;
+    std::vector<UnoPlayer*> seating;
+
+    explicit TournamentTable(int size): 
+        game(GameConfig::forTable(size)), players(), seating() {}
+};
+
+/// @brief Результаты одного потока.
+struct TournamentCounts
+{
+    Matrix games, wins, ahead;
+};
+
+TournamentResult runTournament(const TournamentConfig &config)
+{
+    const int rosterSize = static_cast<int>(config.roster.size());
+    if (config.tableSize < 2 || config.tableSize > rosterSize)
+        throw std::invalid_argument("Invalid table size");
+
+    TournamentResult result;
+    result.tables = scheduleTables(
+        rosterSize, config.tableSize, config.maxTables, config.seed);
+    const Matrix empty(rosterSize, std::vector<std::uint64_t>(rosterSize, 0));
+    result.games = result.wins = result.ahead = empty;
+    if (config.gamesPerTable <= 0) return result;
+
+    const int threads = resolveThreads(config.threads);
+    const std::uint64_t gamesPerTable = config.gamesPerTable;
+    const int size = config.tableSize;
+    std::vector<TournamentCounts> counts(threads, { empty, empty, empty });
+    // current[t] — стол, игроки которого созданы в потоке t
+    std::vector<std::unique_ptr<TournamentTable>> current(threads);
+    std::vector<std::uint64_t> currentIndex(threads, result.tables.size());
+
+    parallelForStealing(result.tables.size() * gamesPerTable, threads,
+        [&](int thread, std::uint64_t task) {
+            const std::uint64_t t = task / gamesPerTable;
+            const std::uint64_t g = task % gamesPerTable;
+            const std::vector<int>& members = result.tables[t];
+            auto& table = current[thread];
+            if (currentIndex[thread] != t)
+            {
+                table.reset(new TournamentTable(size));
+                for (int m : members)
+                {
+                    table->players.push_back(config.roster[m].factory());
+                    table->game.addPlayer(table->players.back().get());
+                }
+                table->seating.resize(size);
+                currentIndex[thread] = t;
+            }
+            for (int k = 0; k < size; ++k)
+                table->seating[(k + g) % size] = table->players[k].get();
+            seatPlayers(table->game, table->seating);
+            table->game.setRandomGeneratorSeed(config.seed + static_cast<unsigned>(g));
+            // Боты получают сиды от стола, игры и места в составе, так что
+            // результат не зависит от того, какой поток проводит игру
+            for (int k = 0; k < size; ++k)
+            {
+                std::seed_seq seq{ config.seed, static_cast<unsigned>(t),
+                    static_cast<unsigned>(g), static_cast<unsigned>(k) };
+                unsigned playerSeed;
+                seq.generate(&playerSeed, &playerSeed + 1);
+                table->players[k]->seed(playerSeed);
+            }
+            const int winner = std::get<0>(table->game.runGame());
+
+            TournamentCounts& own = counts[thread];
+            for (int a = 0; a < size; ++a)
+            {
+                const int i = members[a];
+                const int seat = table->players[a]->playerIndex();
+                const bool won = seat == winner;
+                for (int b = 0; b < size; ++b)
+                {
+                    const int j = members[b];
+                    ++own.games[i][j];
+                    if (won) ++own.wins[i][j];
+                    if (a != b && table->game.scoreOf(seat)
+                        > table->game.scoreOf(table->players[b]->playerIndex()))
+                        ++own.ahead[i][j];
+                }
+            }
+        });
+
+    for (const TournamentCounts& own : counts)
+        for (int i = 0; i < rosterSize; ++i)
+            for (int j = 0; j < rosterSize; ++j)
+            {
+                result.games[i][j] += own.games[i][j];
+                result.wins[i][j] += own.wins[i][j];
+                result.ahead[i][j] += own.ahead[i][j];
+            }
+    return result;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../game/uno_game.h"
+
+/// @brief Участник турнира.
+struct TournamentEntry
+{
+    std::string name;
+    PlayerFactory factory;
+};
+
+/// @brief Параметры турнира.
+struct TournamentConfig
+{
+    /// @brief Участники; за каждым столом сидят разные участники.
+    std::vector<TournamentEntry> roster;
+    /// @brief Число игроков за столом, от 2; для больших столов колод
+    /// берется столько, сколько нужно ( @see GameConfig::forTable ).
+    int tableSize = 2;
+    /// @brief Игр за каждым столом.
+    int gamesPerTable = 100;
+    /// @brief Наибольшее число столов; 0 — все сочетания участников. Если
+    /// сочетаний больше, составляется сбалансированный неполный план.
+    std::uint64_t maxTables = 0;
+    /// @brief Число потоков, 0 — по числу ядер.
+    int threads = 0;
+    /// @brief Базовый сид; игра `g` каждого стола получает сид `seed + g`,
+    /// а игроки стола `t` — сиды из (`seed`, `t`, `g`, место в составе)
+    /// ( @see UnoPlayer::seed ).
+    unsigned seed = 0;
+};
+
+/// @brief Итоги турнира. Индексы — номера участников в `roster`.
+struct TournamentResult
+{
+    /// @brief Составы столов.
+    std::vector<std::vector<int>> tables;
+
+    /// @brief games[i][j] — игр, в которых `i` и `j` сидели за одним столом;
+    /// games[i][i] — все игры участника `i`.
+    std::vector<std::vector<std::uint64_t>> games;
+    /// @brief wins[i][j] — игр с `j`, которые выиграл `i`;
+    /// wins[i][i] — все победы участника `i`.
+    std::vector<std::vector<std::uint64_t>> wins;
+    /// @brief ahead[i][j] — игр, в которых `i` набрал больше очков, чем `j`.
+    std::vector<std::vector<std::uint64_t>> ahead;
+
+    /// @return доля побед участника `i` во всех его играх.
+    double winRate(int i) const;
+    /// @return доля игр с `j`, в которых `i` набрал больше очков; ничьи по
+    /// очкам считаются за половину.
+    double pairScore(int i, int j) const;
+};
+
+/**
+ * @brief Составляет столы турнира.
+ * @details Если сочетаний из `roster.size()` по `tableSize` не больше
+ * `maxTables` (или `maxTables == 0`), возвращаются все сочетания. Иначе
+ * столы набираются жадно: очередным садится участник, сыгравший меньше всех
+ * столов, а при равенстве — реже всех встречавшийся с уже сидящими; так
+ * число столов и число встреч каждой пары выравниваются.
+*/
+std::vector<std::vector<int>> scheduleTables(
+    int rosterSize, int tableSize, std::uint64_t maxTables, unsigned seed = 0);
+
+/**
+ * @brief Проводит турнир: за каждым столом играется `gamesPerTable` игр, в
+ * игре `g` участники сидят по кругу со сдвигом `g % tableSize`.
+ * @details Игры распределяются между потоками с перехватом работы
+ * ( @see parallelForStealing ): длительность игр сильно различается, а
+ * игры одного стола по возможности проводятся одним потоком, чтобы не
+ * пересоздавать игроков.
+ * @throws std::invalid_argument если размер стола некорректен.
+*/
+TournamentResult runTournament(const TournamentConfig& config);
@@ -0,0 +1,197 @@
+#include "trace.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "export.h"
+
+TraceBuffer::TraceBuffer(size_t capacity, int thread):
+    events(capacity), next(0), written(0), thread_(thread)
+{}
+
+size_t TraceBuffer::size() const
+{
+    return written < events.size() ? static_cast<size_t>(written) : events.size();
+}
+
+const TraceEvent &TraceBuffer::at(size_t k) const
+{
+    // Пока буфер не заполнен, старейшее событие лежит в начале
+    const size_t oldest = written < events.size() ? 0 : next;
+    size_t index = oldest + k;
+    if (index >= events.size()) index -= events.size();
+    return events[index];
+}
+
+TraceRecorder::TraceRecorder(int threads, size_t capacity):
+    buffers(), origin(wallClockNanoseconds())
+{
+    if (threads <= 0 || capacity == 0)
+        throw std::invalid_argument("Trace needs at least one thread and one event");
+    for (int t = 0; t < threads; ++t)
+        buffers.emplace_back(new TraceBuffer(capacity, t));
+}
+
+std::uint64_t TraceRecorder::dropped() const
+{
+    std::uint64_t total = 0;
+    for (const auto& buffer : buffers) total += buffer->dropped();
+    return total;
+}
+
+static const char * kindName(TraceKind kind)
+{
+    switch (kind)
+    {
+        case TraceKind::Game: return "Game";
+        case TraceKind::Set: return "Set";
+        case TraceKind::Turn: return "Turn";
+        case TraceKind::PlayCard: return "PlayCard";
+        case TraceKind::DrawAdditionalCard: return "DrawAdditionalCard";
+        case TraceKind::ChangeColor: return "ChangeColor";
+        case TraceKind::Disqualified: return "Disqualified";
+    }
+    return "Unknown";
+}
+
+static const char * argName(TraceKind kind)
+{
+    switch (kind)
+    {
+        case TraceKind::Game: return "game";
+        case TraceKind::Set: return "set";
+        default: return "player";
+    }
+}
+
+/// @brief Записывает наносекунды в микросекундах с тремя знаками.
+static void writeMicroseconds(BufferedWriter& writer, std::uint64_t nanoseconds)
+{
+    writer.writeInt(static_cast<long long>(nanoseconds / 1000));
+    const unsigned fraction = nanoseconds % 1000;
+    writer.put('.');
+    writer.put(static_cast<char>('0' + fraction / 100));
+    writer.put(static_cast<char>('0' + fraction / 10 % 10));
+    writer.put(static_cast<char>('0' + fraction % 10));
+}
+
+static void writeLiteral(BufferedWriter& writer, const char * text)
+{
+    writer.write(text, std::char_traits<char>::length(text));
+}
+
+void TraceRecorder::writeJSON(std::ostream &out) const
+{
+    BufferedWriter writer(out);
+    writeLiteral(writer, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":");
+    writer.writeInt(static_cast<long long>(dropped()));
+    writeLiteral(writer, "},\"traceEvents\":[\n");
+    writeLiteral(writer,
+        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Uno\"}}");
+    for (const auto& buffer : buffers)
+    {
+        const int tid = buffer->thread();
+        writeLiteral(writer, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+        writer.writeInt(tid);
+        writeLiteral(writer, ",\"args\":{\"name\":\"Thread ");
+        writer.writeInt(tid);
+        writeLiteral(writer, "\"}}");
+
+        for (size_t k = 0; k < buffer->size(); ++k)
+        {
+            const TraceEvent& event = buffer->at(k);
+            const bool instant = event.kind == TraceKind::Disqualified;
+            writeLiteral(writer, ",\n{\"name\":\"");
+            writeLiteral(writer, kindName(event.kind));
+            writeLiteral(writer, instant ? "\",\"ph\":\"i\",\"s\":\"t\"" : "\",\"ph\":\"X\"");
+            writeLiteral(writer, ",\"pid\":1,\"tid\":");
+            writer.writeInt(tid);
+            writeLiteral(writer, ",\"ts\":");
+            // События, начавшиеся до создания трассировки, прижимаются к нулю
+            writeMicroseconds(writer, event.start > origin ? event.start - origin : 0);
+            if (!instant)
+            {
+                writeLiteral(writer, ",\"dur\":");
+                writeMicroseconds(writer, event.duration);
+            }
+            writeLiteral(writer, ",\"args\":{\"");
+            writeLiteral(writer, argName(event.kind));
+            writeLiteral(writer, "\":");
+            writer.writeInt(event.arg);
+            writeLiteral(writer, "}}");
+        }
+    }
+    writeLiteral(writer, "\n]}\n");
+}
+
+TraceObserver::TraceObserver(TraceBuffer &buffer):
+    buffer(buffer),
+    gameStart(0), setStart(0), turnStart(0), decisionStart(0),
+    games(0), setNumber(0), turnPlayer(-1)
+{}
+
+void TraceObserver::touch(int playerIndex, std::uint64_t now)
+{
+    if (playerIndex == turnPlayer) return;
+    if (turnPlayer >= 0)
+    {
+        buffer.record(TraceKind::Turn, turnStart, now, turnPlayer);
+        turnStart = now;
+    }
+    turnPlayer = playerIndex;
+}
+
+void TraceObserver::finishSet()
+{
+    const std::uint64_t now = wallClockNanoseconds();
+    if (turnPlayer >= 0) buffer.record(TraceKind::Turn, turnStart, now, turnPlayer);
+    turnPlayer = -1;
+    buffer.record(TraceKind::Set, setStart, now, setNumber);
+}
+
+void TraceObserver::finishGame()
+{
+    buffer.record(TraceKind::Game, gameStart, wallClockNanoseconds(), games);
+}
+
+void TraceObserver::handleSetStarted(int gameNumber)
+{
+    const std::uint64_t now = wallClockNanoseconds();
+    if (gameNumber == 1)
+    {
+        gameStart = now;
+        ++games;
+    }
+    setStart = now;
+    setNumber = gameNumber;
+    turnPlayer = -1;
+}
+
+void TraceObserver::handleFirstCardPlaced(const Card *card)
+{
+    turnStart = wallClockNanoseconds();
+}
+
+void TraceObserver::handlePlayerDisqualified(int playerIndex, int handScore, const Card *card)
+{
+    const std::uint64_t now = wallClockNanoseconds();
+    touch(playerIndex, now);
+    buffer.record(TraceKind::Disqualified, now, now, playerIndex);
+}
+
+void TraceObserver::handleDecisionRequested(
+    const UnoGame &game, int playerIndex, DecisionType type,
+    const Hand &hand, const Card *offered)
+{
+    decisionStart = wallClockNanoseconds();
+    touch(playerIndex, decisionStart);
+}
+
+void TraceObserver::handleDecisionMade(
+    int playerIndex, DecisionType type, const Card *card, CardColor color)
+{
+    TraceKind kind = TraceKind::PlayCard;
+    if (type == DecisionType::DrawAdditionalCard) kind = TraceKind::DrawAdditionalCard;
+    else if (type == DecisionType::ChangeColor) kind = TraceKind::ChangeColor;
+    buffer.record(kind, decisionStart, wallClockNanoseconds(), playerIndex);
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "../game/uno_game.h"
+
+/// @brief Виды событий трассировки.
+enum class TraceKind: std::uint8_t
+{
+    Game,
+    Set,
+    Turn,
+    PlayCard,
+    DrawAdditionalCard,
+    ChangeColor,
+    /// @brief Мгновенное событие: игрок дисквалифицирован.
+    Disqualified,
+};
+
+/// @brief Запись трассировки: отрезок [start; start + duration), нс.
+struct TraceEvent
+{
+    std::uint64_t start, duration;
+    /// @brief Номер игры, номер партии или номер игрока, по виду события.
+    std::int32_t arg;
+    TraceKind kind;
+};
+
+/**
+ * @brief Кольцевой буфер событий трассировки одного потока.
+ * @details Заполненный буфер перезаписывает самые старые события. Записи
+ * добавляются по окончании отрезка целиком, так что перезапись не
+ * оставляет незакрытых отрезков.
+*/
+class TraceBuffer
+{
+    std::vector<TraceEvent> events;
+    size_t next;
+    std::uint64_t written;
+    int thread_;
+
+public:
+    TraceBuffer(size_t capacity, int thread);
+
+    void record(TraceKind kind, std::uint64_t start, std::uint64_t end, std::int32_t arg)
+    {
+        events[next] = TraceEvent{start, end - start, arg, kind};
+        if (++next == events.size()) next = 0;
+        ++written;
+    }
+
+    int thread() const { return thread_; }
+    /// @return число хранящихся событий.
+    size_t size() const;
+    /// @return число перезаписанных событий.
+    std::uint64_t dropped() const { return written - size(); }
+    /// @return `k`-тое хранящееся событие, от старых к новым.
+    const TraceEvent& at(size_t k) const;
+    void clear() { next = 0; written = 0; }
+};
+
+/**
+ * @brief Трассировка нескольких потоков в формате Chrome trace-event JSON
+ * (открывается в chrome://tracing и Perfetto).
+ * @details У каждого потока свой буфер ( @see buffer ), так что запись
+ * события — чтение часов и запись в память без синхронизации. События
+ * потока показываются на отдельной дорожке. Время отсчитывается от
+ * создания объекта.
+*/
+class TraceRecorder
+{
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+    std::uint64_t origin;
+
+public:
+    /// @param threads число потоков.
+    /// @param capacity число событий в буфере каждого потока.
+    /// @throws std::invalid_argument если `threads` или `capacity` не
+    /// положительны.
+    explicit TraceRecorder(int threads, size_t capacity = size_t(1) << 20);
+
+    /// @return буфер потока `thread` (номер потока parallelFor).
+    TraceBuffer& buffer(int thread) { return *buffers.at(thread); }
+    int threads() const { return buffers.size(); }
+    /// @return число перезаписанных событий во всех буферах.
+    std::uint64_t dropped() const;
+
+    /// @brief Выводит события всех потоков в формате JSON Object Format.
+    void writeJSON(std::ostream& out) const;
+};
+
+/**
+ * @brief Наблюдатель, записывающий в буфер трассировки отрезки игр, партий,
+ * ходов и решений игроков.
+ * @details Подключается к игре и как наблюдатель, и как наблюдатель за
+ * решениями:
+ *     game.addObserver(&tracer);
+ *     game.addDecisionObserver(&tracer);
+ * Ход игрока длится от конца предыдущего хода до первого события
+ * следующего игрока, первый ход партии — от выкладывания первой карты.
+*/
+class TraceObserver: public Observer, public DecisionObserver
+{
+    TraceBuffer& buffer;
+    std::uint64_t gameStart, setStart, turnStart, decisionStart;
+    int games, setNumber;
+    /// @brief Игрок, чей ход идет, или -1.
+    int turnPlayer;
+
+    /// @brief Отмечает событие игрока `playerIndex`; если ходил другой
+    /// игрок, его ход заканчивается.
+    void touch(int playerIndex, std::uint64_t now);
+    void finishSet();
+    void finishGame();
+
+public:
+    explicit TraceObserver(TraceBuffer& buffer);
+
+    // Методы наблюдателя
+
+    void handleSetStarted(int gameNumber) override;
+    void handleFirstCardPlaced(const Card * card) override;
+    void handleCardPlayed(int playerIndex, const Card * card) override
+        { touch(playerIndex, wallClockNanoseconds()); }
+    void handlePlayerDrewAnotherCard(int playerIndex) override
+        { touch(playerIndex, wallClockNanoseconds()); }
+    void handlePlayerDrewAndSkip(int playerIndex, int numberOfCards) override
+        { touch(playerIndex, wallClockNanoseconds()); }
+    void handlePlayerChangedColor(int playerIndex, CardColor newColor) override
+        { touch(playerIndex, wallClockNanoseconds()); }
+    void handlePlayerDisqualified(int playerIndex, int handScore, const Card * card) override;
+    void handlePlayerWonSet(int playerIndex, int score) override { finishSet(); }
+    void handleTurnsLimitReached() override { finishSet(); }
+    void handlePlayerWonGame(int playerIndex, int totalScore) override { finishGame(); }
+    void handleSetsLimitReached(int winnerIndex, int winnerScore) override { finishGame(); }
+
+    // Методы наблюдателя за решениями
+
+    void handleDecisionRequested(
+        const UnoGame& game,
+        int playerIndex,
+        DecisionType type,
+        const Hand& hand,
+        const Card * offered) override;
+    void handleDecisionMade(
+        int playerIndex,
+        DecisionType type,
+        const Card * card,
+        CardColor color) override;
+};
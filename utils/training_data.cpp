@@ -0,0 +1,126 @@
+#include "training_data.h"
+
+void DecisionBlock::reserve(size_t rows)
+{
+    features.reserve(rows * FeatureLayout::SIZE);
+    masks.reserve(rows);
+    actions.reserve(rows);
+    players.reserve(rows);
+    outcomes.reserve(rows);
+}
+
+void DecisionBlock::truncate(size_t rows)
+{
+    features.resize(rows * FeatureLayout::SIZE);
+    masks.resize(rows);
+    actions.resize(rows);
+    players.resize(rows);
+    outcomes.resize(rows);
+}
+
+template<class T>
+static size_t writeColumn(std::ostream& out, const std::vector<T>& column)
+{
+    const size_t size = column.size() * sizeof(T);
+    out.write(reinterpret_cast<const char *>(column.data()), size);
+    return size;
+}
+
+size_t writeDecisionBlock(std::ostream &out, const DecisionBlock &block)
+{
+    const DecisionBlockHeader header = {
+        { 'U', 'N', 'O', 'D' }, 1,
+        FeatureLayout::SIZE, ActionSpace::SIZE, 0,
+        static_cast<std::uint32_t>(block.rows())
+    };
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    size_t size = sizeof(header);
+    size += writeColumn(out, block.features);
+    size += writeColumn(out, block.masks);
+    size += writeColumn(out, block.actions);
+    size += writeColumn(out, block.players);
+    size += writeColumn(out, block.outcomes);
+    return size;
+}
+
+TrainingDataRecorder::TrainingDataRecorder(std::ostream *out, size_t blockRows):
+    out(out),
+    block(),
+    blockRows(blockRows),
+    setBegin(0),
+    decisions(0),
+    bytes(0)
+{
+    // Блок записывается только после конца партии, так что он может
+    // немного превысить blockRows
+    block.reserve(blockRows + blockRows / 4);
+}
+
+TrainingDataRecorder::~TrainingDataRecorder()
+{
+    flush();
+}
+
+size_t TrainingDataRecorder::writeBlock(DecisionBlock &block)
+{
+    size_t size = out == nullptr ? 0 : writeDecisionBlock(*out, block);
+    block.clear();
+    return size;
+}
+
+void TrainingDataRecorder::flush()
+{
+    if (setBegin == 0) return;
+    // Решения незаконченной партии не записываются
+    block.truncate(setBegin);
+    decisions += block.rows();
+    bytes += writeBlock(block);
+    setBegin = 0;
+}
+
+void TrainingDataRecorder::finishSet(int winnerIndex)
+{
+    for (size_t i = setBegin; i < block.rows(); ++i)
+        block.outcomes[i] = winnerIndex < 0 ? -1 : block.players[i] == winnerIndex;
+    setBegin = block.rows();
+    if (setBegin >= blockRows) flush();
+}
+
+void TrainingDataRecorder::handleDecisionRequested(
+    const UnoGame &game,
+    int playerIndex,
+    DecisionType type,
+    const Hand &hand,
+    const Card *offered)
+{
+    const size_t row = block.rows();
+    block.truncate(row + 1);
+    encodeDecision(game, playerIndex, hand.begin(), hand.end(), type,
+        block.features.data() + row * FeatureLayout::SIZE);
+
+    legalActions(game, hand.begin(), hand.end(), type, offered, mask);
+    std::uint64_t bits = 0;
+    for (int a = 0; a < ActionSpace::SIZE; ++a)
+        if (mask[a]) bits |= std::uint64_t(1) << a;
+    block.masks[row] = bits;
+    block.actions[row] = -1;
+    block.players[row] = static_cast<std::uint8_t>(playerIndex);
+}
+
+void TrainingDataRecorder::handleDecisionMade(
+    int playerIndex,
+    DecisionType type,
+    const Card *card,
+    CardColor color)
+{
+    if (block.rows() == setBegin) return;
+    block.actions.back() = static_cast<std::int8_t>(
+        decisionAction(type, card, color));
+}
+
+void TrainingDataRecorder::handleSetStarted(int gameNumber)
+{
+    // Решения прерванной партии отбрасываются
+    block.truncate(setBegin);
+}
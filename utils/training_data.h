@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "../game/uno_game.h"
+#include "decision_features.h"
+
+static_assert(ActionSpace::SIZE <= 64, "Action mask must fit into 64 bits");
+
+/**
+ * @brief Блок записанных решений, хранится по столбцам.
+ *
+ * @details Строка `i` блока — одно решение: признаки
+ * `features[i * FeatureLayout::SIZE ...]`, маска допустимых действий
+ * `masks[i]` (бит `a` — действие `a`), выбранное действие `actions[i]`
+ * (-1, если решение не соответствует действию), номер игрока `players[i]` и
+ * итог партии для этого игрока `outcomes[i]`: 1 — выиграл, 0 — проиграл,
+ * -1 — ничья по лимиту ходов.
+*/
+struct DecisionBlock
+{
+    std::vector<std::int8_t>   features;
+    std::vector<std::uint64_t> masks;
+    std::vector<std::int8_t>   actions;
+    std::vector<std::uint8_t>  players;
+    std::vector<std::int8_t>   outcomes;
+
+    /// @return количество решений в блоке.
+    size_t rows() const { return actions.size(); }
+
+    /// @brief Резервирует место под `rows` решений.
+    void reserve(size_t rows);
+
+    /// @brief Удаляет решения, начиная с `rows`-того.
+    void truncate(size_t rows);
+
+    void clear() { truncate(0); }
+};
+
+/// @brief Заголовок блока решений в двоичном виде ( @see writeDecisionBlock ).
+struct DecisionBlockHeader
+{
+    /// @brief "UNOD".
+    char          magic[4];
+    /// @brief Версия формата, 1.
+    std::uint16_t version;
+    /// @brief FeatureLayout::SIZE.
+    std::uint16_t featureSize;
+    /// @brief ActionSpace::SIZE.
+    std::uint16_t actionSize;
+    std::uint16_t reserved;
+    std::uint32_t rows;
+};
+static_assert(sizeof(DecisionBlockHeader) == 16, "Unexpected header padding");
+
+/**
+ * @brief Записывает блок решений в двоичном виде.
+ * @details Формат блока (числа в порядке байт машины, обычно little-endian):
+ *
+ *     DecisionBlockHeader        — 16 байт
+ *     int8     features[rows * featureSize]
+ *     uint64   masks[rows]
+ *     int8     actions[rows]
+ *     uint8    players[rows]
+ *     int8     outcomes[rows]
+ *
+ * Файл — последовательность таких блоков.
+ * @return количество записанных байт.
+*/
+size_t writeDecisionBlock(std::ostream& out, const DecisionBlock& block);
+
+/// @return размер в байтах блока из `rows` решений в двоичном виде.
+inline size_t decisionBlockBytes(size_t rows)
+{
+    return sizeof(DecisionBlockHeader) 
+        + rows * (FeatureLayout::SIZE + sizeof(std::uint64_t) + 3);
+}
+
+/**
+ * @brief Записывает решения всех игроков (признаки, маску допустимых действий,
+ * выбранное действие) и итог партии в двоичный столбцовый файл.
+ *
+ * @details Наблюдатель нужно подключить к игре дважды: как наблюдателя за
+ * событиями (`addObserver`), чтобы узнавать итоги партий, и как наблюдателя за
+ * решениями (`addDecisionObserver`).
+ *
+ * Решения партии копятся в текущем блоке; когда партия закончена и в блоке
+ * набралось `blockRows` решений, блок записывается методом `writeBlock`.
+ * Решения незаконченной партии не записываются. За столом может быть не
+ * больше FeatureLayout::SEATS игроков ( @see encodeDecision ).
+*/
+class TrainingDataRecorder: public Observer, public DecisionObserver
+{
+    std::ostream * out;
+    DecisionBlock block;
+    size_t blockRows;
+    /// @brief Номер первой строки текущей партии в блоке.
+    size_t setBegin;
+
+    std::uint8_t mask[ActionSpace::SIZE];
+
+    std::uint64_t decisions;
+    std::uint64_t bytes;
+
+    /// @brief Проставляет итог партии решениям текущей партии.
+    /// @param winnerIndex победитель или -1 при ничьей.
+    void finishSet(int winnerIndex);
+
+protected:
+    /// @brief Сохраняет заполненный блок и очищает его. По умолчанию пишет
+    /// блок в поток (см. writeDecisionBlock).
+    /// @return количество записанных байт.
+    virtual size_t writeBlock(DecisionBlock& block);
+
+public:
+    /// @param out поток, открытый в двоичном режиме; может быть nullptr, если
+    /// `writeBlock` переопределен.
+    /// @param blockRows примерный размер блока в решениях.
+    TrainingDataRecorder(std::ostream * out, size_t blockRows = 1 << 16);
+
+    /// @brief Записывает накопленные решения законченных партий.
+    /// @details Наследники, переопределившие `writeBlock`, должны вызвать
+    /// `flush` в своем деструкторе.
+    virtual ~TrainingDataRecorder();
+
+    /// @brief Записывает накопленные решения законченных партий.
+    void flush();
+
+    /// @return количество записанных решений.
+    std::uint64_t decisionsWritten() const { return decisions; }
+    /// @return количество записанных байт.
+    std::uint64_t bytesWritten() const { return bytes; }
+
+    // Методы наблюдателя за решениями
+
+    void handleDecisionRequested(
+        const UnoGame& game,
+        int playerIndex,
+        DecisionType type,
+        const Hand& hand,
+        const Card * offered) override;
+
+    void handleDecisionMade(
+        int playerIndex,
+        DecisionType type,
+        const Card * card,
+        CardColor color) override;
+
+    // Методы наблюдателя
+
+    void handleSetStarted(int gameNumber) override;
+    void handlePlayerWonSet(int playerIndex, int score) override
+        { finishSet(playerIndex); }
+    void handleTurnsLimitReached() override
+        { finishSet(-1); }
+};
@@ -0,0 +1,143 @@
+#include "tuning.h"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+#include "parallel.h"
+#include "stats.h"
+
+/// @brief Стол одного кандидата в одном потоке.
+struct TuningTable
+{
+    UnoGame game;
+    std::vector<std::unique_ptr<UnoPlayer>> players;
+    /// @brief Порядок игроков при рассадке; кандидат первый.
+    std::vector<UnoPlayer*> order;
+    std::vector<UnoPlayer*> seating;
+};
+
+std::vector<double> evaluateCandidates(
+    const TuningConfig &config,
+    const std::vector<std::vector<double>> &candidates,
+    unsigned seed)
+{
+    const int threads = resolveThreads(config.threads);
+    const std::uint64_t games = config.gamesPerEvaluation;
+    const size_t n = candidates.size();
+
+    // tables[t][c] — стол кандидата c в потоке t, создается при первой игре
+    std::vector<std::vector<std::unique_ptr<TuningTable>>> tables(threads);
+    std::vector<std::vector<std::uint64_t>> wins(
+        threads, std::vector<std::uint64_t>(n, 0));
+    for (auto& row : tables) row.resize(n);
+
+    parallelFor(n * games, threads, 16, [&](int thread, std::uint64_t task) {
+        const size_t c = task / games;
+        const std::uint64_t g = task % games;
+        auto& table = tables[thread][c];
+        if (!table)
+        {
+            table.reset(new TuningTable());
+            table->players.push_back(config.candidate(candidates[c]));
+            for (const PlayerFactory& factory : config.opponents)
+                table->players.push_back(factory());
+            for (auto& player : table->players)
+            {
+                table->game.addPlayer(player.get());
+                table->order.push_back(player.get());
+            }
+            table->seating.resize(table->order.size());
+        }
+        // Кандидат садится на место g % players, соперники — по кругу за ним
+        const size_t players = table->order.size();
+        for (size_t k = 0; k < players; ++k)
+            table->seating[(k + g) % players] = table->order[k];
+        seatPlayers(table->game, table->seating);
+        table->game.setRandomGeneratorSeed(seed + static_cast<unsigned>(g));
+        for (size_t k = 0; k < players; ++k)
+        {
+            std::seed_seq seq{ seed, static_cast<unsigned>(g), static_cast<unsigned>(k) };
+            unsigned playerSeed;
+            seq.generate(&playerSeed, &playerSeed + 1);
+            table->order[k]->seed(playerSeed);
+        }
+
+        int winner = std::get<0>(table->game.runGame());
+        if (winner >= 0 && winner == table->order.front()->playerIndex())
+            ++wins[thread][c];
+    });
+
+    std::vector<double> rates(n, 0);
+    for (size_t c = 0; c < n; ++c)
+    {
+        std::uint64_t total = 0;
+        for (int t = 0; t < threads; ++t) total += wins[t][c];
+        rates[c] = games == 0 ? 0 : static_cast<double>(total) / games;
+    }
+    return rates;
+}
+
+/// @brief Ограничивает параметры границами из config.
+static void clampParams(const TuningConfig& config, std::vector<double>& params)
+{
+    for (size_t i = 0; i < params.size(); ++i)
+    {
+        if (i < config.lowerBounds.size())
+            params[i] = std::max(params[i], config.lowerBounds[i]);
+        if (i < config.upperBounds.size())
+            params[i] = std::min(params[i], config.upperBounds[i]);
+    }
+}
+
+TuningResult tuneSpsa(const TuningConfig &config)
+{
+    if (config.initial.empty())
+        throw std::invalid_argument("No parameters to tune");
+    if (config.opponents.empty())
+        throw std::invalid_argument("No opponents to tune against");
+
+    std::mt19937 random(config.seed);
+    std::bernoulli_distribution coin(0.5);
+    const size_t dimension = config.initial.size();
+    const unsigned gamesPerEvaluation = config.gamesPerEvaluation;
+
+    TuningResult result;
+    result.params = config.initial;
+    clampParams(config, result.params);
+    std::vector<double> delta(dimension);
+    std::vector<std::vector<double>> candidates(2, result.params);
+
+    for (int k = 0; k < config.iterations; ++k)
+    {
+        const double ak = config.a / std::pow(k + 1 + config.A, config.alpha);
+        const double ck = config.c / std::pow(k + 1, config.gamma);
+        for (size_t i = 0; i < dimension; ++i)
+        {
+            delta[i] = coin(random) ? 1 : -1;
+            candidates[0][i] = result.params[i] + ck * delta[i];
+            candidates[1][i] = result.params[i] - ck * delta[i];
+        }
+        clampParams(config, candidates[0]);
+        clampParams(config, candidates[1]);
+
+        // Раздачи итерации k общие для обоих кандидатов
+        const unsigned seed = config.seed + (k + 1) * gamesPerEvaluation;
+        std::vector<double> rates = evaluateCandidates(config, candidates, seed);
+        result.games += 2 * static_cast<std::uint64_t>(gamesPerEvaluation);
+
+        const double gradient = (rates[0] - rates[1]) / (2 * ck);
+        for (size_t i = 0; i < dimension; ++i)
+            result.params[i] += ak * gradient * delta[i];
+        clampParams(config, result.params);
+
+        if (config.progress)
+            config.progress(k, result.params, (rates[0] + rates[1]) / 2);
+    }
+
+    // Итоговая оценка на раздачах, которые не использовались при настройке
+    const unsigned seed = config.seed + (config.iterations + 1) * gamesPerEvaluation;
+    result.winRate = evaluateCandidates(config, { result.params }, seed).front();
+    result.games += gamesPerEvaluation;
+    return result;
+}
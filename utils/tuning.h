@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../game/uno_game.h"
+
+/// @brief Фабрика настраиваемого игрока по вектору параметров.
+using ParametrizedFactory =
+    std::function<std::unique_ptr<UnoPlayer>(const std::vector<double>&)>;
+
+/// @brief Параметры настройки стратегии.
+struct TuningConfig
+{
+    /// @brief Настраиваемый игрок.
+    ParametrizedFactory candidate;
+    /// @brief Соперники; за столом сидят кандидат и все соперники.
+    std::vector<PlayerFactory> opponents;
+
+    /// @brief Начальные параметры.
+    std::vector<double> initial;
+    /// @brief Границы параметров; пустой вектор — без ограничений.
+    std::vector<double> lowerBounds, upperBounds;
+
+    /// @brief Число итераций SPSA.
+    int iterations = 100;
+    /// @brief Игр на оценку одного вектора параметров.
+    int gamesPerEvaluation = 1000;
+    /// @brief Число потоков, 0 — по числу ядер.
+    int threads = 0;
+    /// @brief Базовый сид раздач.
+    unsigned seed = 0;
+
+    // Коэффициенты SPSA: шаг a_k = a / (k + 1 + A)^alpha,
+    // возмущение c_k = c / (k + 1)^gamma.
+    double a = 1, c = 0.5, A = 10, alpha = 0.602, gamma = 0.101;
+
+    /// @brief Вызывается после каждой итерации с текущими параметрами и
+    /// средней долей побед двух возмущенных кандидатов.
+    std::function<void(int, const std::vector<double>&, double)> progress;
+};
+
+/// @brief Итоги настройки.
+struct TuningResult
+{
+    std::vector<double> params;
+    /// @brief Доля побед с итоговыми параметрами на отдельной выборке раздач.
+    double winRate = 0;
+    /// @brief Всего сыграно игр.
+    std::uint64_t games = 0;
+};
+
+/**
+ * @brief Оценивает несколько векторов параметров на одинаковых раздачах.
+ * @param seed сид первой раздачи; игра `g` каждого кандидата проводится с
+ * сидом `seed + g`, а кандидат садится на место `g % числа игроков`, так что
+ * все кандидаты играют одни и те же раздачи с одних и тех же мест (общие
+ * случайные числа). Генераторы игроков ( @see UnoPlayer::seed ) получают
+ * сид по сиду игры и номеру игрока, так что и боты делают одинаковые
+ * случайные выборы.
+ * @return доли побед кандидатов.
+ * @details Все `candidates.size() * gamesPerEvaluation` игр распределяются
+ * между всеми потоками.
+*/
+std::vector<double> evaluateCandidates(
+    const TuningConfig& config,
+    const std::vector<std::vector<double>>& candidates,
+    unsigned seed);
+
+/**
+ * @brief Настраивает параметры методом SPSA, максимизируя долю побед.
+ * @details На итерации `k` оцениваются два кандидата θ ± c_k·Δ, где Δ —
+ * случайный вектор из ±1, на одинаковых раздачах, после чего
+ * θ += a_k · (f+ − f−) / (2 c_k) · Δ. Каждая итерация использует новые
+ * раздачи.
+ * @throws std::invalid_argument если нет начальных параметров или соперников.
+*/
+TuningResult tuneSpsa(const TuningConfig& config);